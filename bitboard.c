@@ -0,0 +1,89 @@
+#include "bitboard.h"
+
+// Fills the board with the given points.
+// Returns 0 if the padded bounding box doesn't fit in the slabs,
+// in which case the caller needs to fall back to the spacemap.
+int bitboard_fill(Bitboard* board, const Point* points, int length) {
+	Point dim[3];
+	dim[0] = 0;
+	dim[1] = 0;
+	dim[2] = 0;
+	
+	for (int i = 0; i < length; i++) {
+		Point p = points[i];
+		if ((p & POINT_MASK_X) > dim[0]) dim[0] = p & POINT_MASK_X;
+		if ((p & POINT_MASK_Y) > dim[1]) dim[1] = p & POINT_MASK_Y;
+		if ((p & POINT_MASK_Z) > dim[2]) dim[2] = p & POINT_MASK_Z;
+	}
+	
+	int width = POINT_GET_X(dim[0]) + 2;
+	int rows = POINT_GET_Y(dim[1]) + 2;
+	int slab_count = POINT_GET_Z(dim[2]) + 2;
+	
+	if (width * rows > BITBOARD_SLAB_BITS || slab_count > BITBOARD_MAX_SLABS) return 0;
+	
+	board->width = width;
+	board->slab_count = slab_count;
+	
+	for (int z = 0; z < slab_count; z++) {
+		board->slabs[z] = 0;
+	}
+	
+	for (int i = 0; i < length; i++) {
+		Point p = points[i];
+		int bit = POINT_GET_Y(p) * width + POINT_GET_X(p);
+		board->slabs[POINT_GET_Z(p)] |= 1ull << bit;
+	}
+	
+	return 1;
+}
+
+// Dilates every slab by one in the six face directions and removes
+// the occupied bits, leaving exactly the unique candidate points.
+// The padding guarantees the shifts never wrap between rows.
+int bitboard_get_candidates(const Bitboard* board, Point* candidates) {
+	int width = board->width;
+	int index = 0;
+	
+	// Exact for every bit index below 2^16 / width, which covers the slab
+	uint32_t reciprocal = (65536 + width - 1) / width;
+	
+	for (int z = 0; z < board->slab_count; z++) {
+		uint64_t s = board->slabs[z];
+		uint64_t d = (s << 1) | (s >> 1) | (s << width) | (s >> width);
+		
+		if (z > 0) d |= board->slabs[z - 1];
+		if (z + 1 < board->slab_count) d |= board->slabs[z + 1];
+		
+		d &= ~s;
+		
+		while (d) {
+			int bit = __builtin_ctzll(d);
+			d &= d - 1;
+			
+			int y = (bit * reciprocal) >> 16;
+			int x = bit - y * width;
+			
+			candidates[index] = POINT_SET_X(x) + POINT_SET_Y(y) + POINT_SET_Z(z);
+			index++;
+		}
+	}
+	
+	return index;
+}
+
+// Counts the occupied neighbors of a point inside the board
+int bitboard_count_neighbors(const Bitboard* board, Point point) {
+	int z = POINT_GET_Z(point);
+	int bit = POINT_GET_Y(point) * board->width + POINT_GET_X(point);
+	
+	uint64_t s = board->slabs[z] >> (bit - board->width);
+	uint64_t mask = 1 | (0x5ull << (board->width - 1)) | (1ull << (board->width << 1));
+	
+	int count = __builtin_popcountll(s & mask);
+	
+	count += (board->slabs[z - 1] >> bit) & 1;
+	count += (board->slabs[z + 1] >> bit) & 1;
+	
+	return count;
+}
@@ -0,0 +1,23 @@
+#include <stdint.h>
+
+#include "point.h"
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#define BITBOARD_SLAB_BITS 64
+#define BITBOARD_MAX_SLABS 32
+
+// Bit packed occupancy of a key's bounding box, padded by one in each direction.
+// Each z value gets one slab, with rows of "width" bits for each y value.
+typedef struct {
+	uint64_t slabs[BITBOARD_MAX_SLABS];
+	int width;
+	int slab_count;
+} Bitboard;
+
+int bitboard_fill(Bitboard* board, const Point* points, int length);
+int bitboard_get_candidates(const Bitboard* board, Point* candidates);
+int bitboard_count_neighbors(const Bitboard* board, Point point);
+
+#endif
@@ -187,7 +187,7 @@ Key bitface_unpack(char* buffer, uint8_t length) {
 	return retval;
 }
 
-uint64_t bitface_read_keys(InputStream* stream, Key* keys, uint8_t length, uint64_t count) {
+uint64_t bitface_read_keys(InputStream* stream, KeyList* keys, uint8_t length, uint64_t count) {
 	size_t raw_size = bitface_key_size(length);
 	size_t in_buf_size = count * raw_size;
 	char buffer[in_buf_size];
@@ -201,7 +201,9 @@ uint64_t bitface_read_keys(InputStream* stream, Key* keys, uint8_t length, uint6
 	size_t n_read = read_count / raw_size;
 	
 	for (uint64_t i = 0; i < n_read; i++) {	
-		keys[i] = bitface_unpack(&buffer[i * raw_size], length);
+		Key key = bitface_unpack(&buffer[i * raw_size], length);
+		key.source_index = 0;
+		key_list_set(keys, i, &key);
 	}
 	
 	return n_read;
@@ -216,10 +218,25 @@ uint64_t bitface_read_count(InputStream* stream, uint8_t length) {
 	return count;
 }
 
-void bitface_write_keys(OutputStream* stream, Key* keys, uint64_t count, uint8_t* places) {
+// Packs the first count keys of a list back to back.
+// Returns the number of bytes written.
+size_t bitface_encode_keys(const KeyList* keys, uint64_t count, uint8_t* buffer, uint8_t* places) {
+	uint8_t length = keys->length;
+	size_t raw_size = bitface_key_size(length);
+	
+	memset(buffer, 0, count * raw_size);
+	
+	for (uint64_t i = 0; i < count; i++) {
+		bitface_pack(key_list_get(keys, i), length, (char*) &buffer[i * raw_size], places);
+	}
+	
+	return count * raw_size;
+}
+
+void bitface_write_keys(OutputStream* stream, KeyList* keys, uint64_t count, uint8_t* places) {
 	if (count < 1) return;
 	
-	uint8_t length = keys[0].length;
+	uint8_t length = keys->length;
 	size_t raw_size = bitface_key_size(length);
 	
 	char buffer[raw_size];
@@ -227,7 +244,7 @@ void bitface_write_keys(OutputStream* stream, Key* keys, uint64_t count, uint8_t
 	for (uint64_t i = 0; i < count; i++) {
 		memset(buffer, 0, raw_size);
 		
-		bitface_pack(keys[i], length, buffer, places);
+		bitface_pack(key_list_get(keys, i), length, buffer, places);
 		
 		output_stream_write(stream, buffer, raw_size);
 	}
@@ -0,0 +1,24 @@
+#include <pthread.h>
+
+#include "cpu.h"
+
+#ifdef CPU_X86_SIMD
+static int has_avx2 = 0;
+static pthread_once_t cpu_once = PTHREAD_ONCE_INIT;
+
+void cpu_init() {
+	has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+}
+#endif
+
+// Checks once if the processor supports AVX2.
+// Worker threads call this concurrently, so the check runs under pthread_once.
+int cpu_has_avx2() {
+#ifdef CPU_X86_SIMD
+	pthread_once(&cpu_once, cpu_init);
+	
+	return has_avx2;
+#else
+	return 0;
+#endif
+}
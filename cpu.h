@@ -0,0 +1,12 @@
+#ifndef CPU_H
+#define CPU_H
+
+// SIMD kernels are built with per-function target attributes,
+// so they only exist for x86 builds using GCC compatible compilers
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_X86_SIMD 1
+#endif
+
+int cpu_has_avx2();
+
+#endif
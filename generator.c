@@ -1,6 +1,9 @@
 #include <stdio.h>
+#include <pthread.h>
 
 #include "generator.h"
+#include "generator_avx2.h"
+#include "bitboard.h"
 #include "network_sort.h"
 #include "point.h"
 #include "key.h"
@@ -17,6 +20,9 @@
 #define ROT_ZX  0xF0000
 #define ROT_ZY  0xF00000
 
+// Fewest enabled rotations for which the transposed batch sort is used
+#define GENERATOR_BATCH_MIN_ROTATIONS 8
+
 // This function determines the new dimensions of the expanded region
 // Higher face IDs still increase the region size, so we use % 3
 // to capture the dimension
@@ -42,7 +48,14 @@ int get_expand_face(Point point, Point dim) {
 }
 
 // Creates the candidates by placing all adjacent points, removing the existing points, and returning unique values
-int generator_create_candidates(Key key, size_t length, Point* candidates, uint8_t* spacemap) {
+// The bitboard handles any key whose bounding box fits in its slabs,
+// otherwise we use the spacemap
+int generator_create_candidates(const Key* key, size_t length, Point* candidates, uint8_t* spacemap) {
+	Bitboard board;
+	if (bitboard_fill(&board, key->data, length)) {
+		return bitboard_get_candidates(&board, candidates);
+	}
+	
 	int full_count = 6 * length;
 	Point initial_candidates[full_count];
 	
@@ -50,7 +63,7 @@ int generator_create_candidates(Key key, size_t length, Point* candidates, uint8
 	int index = 0;
 	for (int face = 0; face < 6; face++) {
 		for (size_t i = 0; i < length; i++) {
-			Point pt = point_get_offset(key.data[i], face);
+			Point pt = point_get_offset(key->data[i], face);
 			initial_candidates[index] = pt;
 			spacemap[pt] = 1;
 			index++;
@@ -59,7 +72,7 @@ int generator_create_candidates(Key key, size_t length, Point* candidates, uint8
 	
 	// Unset existing points
 	for (int i = 0; i < length; i++) {
-		spacemap[key.data[i]] = 0;
+		spacemap[key->data[i]] = 0;
 	}
 	
 	// Retrieve candidates
@@ -76,21 +89,44 @@ int generator_create_candidates(Key key, size_t length, Point* candidates, uint8
 	return index;
 }
 
-// Generates relevant rotated keys for the given starting key
-// Returns a mask to test for which rotations were computed
+// Rotates every point for all enabled rotations except the identity,
+// writing the unsorted results into the rotated keys
+void generator_rotate_scalar(const Point* points, size_t length, Point dim, uint32_t rotation_bits, Key* rkeys) {
+	PointData pdata[length];
+	
+	for (size_t i = 0; i < length; i++) {
+		pdata[i] = point_get_data(points[i], dim);
+	}
+	
+	for (size_t i = 1; i < NUM_ROTATIONS; i++) {
+		if (!(rotation_bits & (1 << i))) continue;
+		
+		Point* kdata = rkeys[i].data;
+		
+		const uint8_t* r = point_get_rotation_data(i);
+		uint8_t r0 = r[0];
+		uint8_t r1 = r[1];
+		uint8_t r2 = r[2];
+		
+		for (size_t j = 0; j < length; j++) {
+			uint8_t* p = pdata[j].data;
+			kdata[j] = POINT_SET_X(p[r0]) + POINT_SET_Y(p[r1]) + POINT_SET_Z(p[r2]);
+		}
+	}
+}
+
+// Returns a mask of the rotations needed for the given dimensions
 // We eliminate some rotations by looking at the dimensions
 // If we have a single maximum dimension, we use the 8 rotations from that axis
 // Else if we have a single minimum dimension, we use the 8 rotations from that axis
 // Eliminate further rotations by checking if other dimensions are not equal
 // Otherwise we compute all rotations
-uint32_t generator_create_rotations(Key key, size_t length, Point dim, Key* rkeys) {
+uint32_t generator_get_rotation_mask(Point dim) {
 	uint8_t d0 = POINT_GET_X(dim);
 	uint8_t d1 = POINT_GET_Y(dim);
 	uint8_t d2 = POINT_GET_Z(dim);
 	uint32_t rotation_bits = 0;
 	
-	Point bigpoint = POINT_MAX; // 32,32,32
-	
 	if ((d0 == d1) && (d0 == d2)) {
 		rotation_bits = ROT_ALL;
 	} else if (d1 == d2) {
@@ -110,41 +146,373 @@ uint32_t generator_create_rotations(Key key, size_t length, Point dim, Key* rkey
 		else rotation_bits = ROT_ZY;
 	}
 	
-	PointData pdata[length];
+	return rotation_bits;
+}
+
+// Generates relevant rotated keys for the given starting key
+// Returns a mask to test for which rotations were computed
+uint32_t generator_create_rotations(const Key* key, size_t length, Point dim, Key* rkeys) {
+	uint32_t rotation_bits = generator_get_rotation_mask(dim);
 	
-	for (size_t i = 0; i < length; i++) {
-		pdata[i] = point_get_data(key.data[i], dim);
-	}
+	generator_rotate_keys(key, length, dim, rotation_bits, rkeys);
+	
+	return rotation_bits;
+}
+
+// Computes the sorted rotated keys for the rotations in rotation_bits
+void generator_rotate_keys(const Key* key, size_t length, Point dim, uint32_t rotation_bits, Key* rkeys) {
+	Point bigpoint = POINT_MAX; // 32,32,32
 	
-	rkeys[0] = key;
+	rkeys[0] = *key;
+	
+	// Rotate all points, using the vector kernel where available
+	// The vector kernel also sorts the points if it has a network for this length
+	// With partial sorting, the points are left unsorted for the merge loop to order
+	int sorted = 0;
+#ifdef GENERATOR_PARTIAL_SORT
+	sorted = 1;
+	
+#ifdef CPU_X86_SIMD
+	if (cpu_has_avx2()) {
+		generator_rotate_avx2(key->data, length, dim, rotation_bits, rkeys);
+	} else {
+		generator_rotate_scalar(key->data, length, dim, rotation_bits, rkeys);
+	}
+#else
+	generator_rotate_scalar(key->data, length, dim, rotation_bits, rkeys);
+#endif
+#elif defined(CPU_X86_SIMD)
+	if (cpu_has_avx2()) {
+		// With enough rotations enabled, sort them all together in one transposed batch
+		if (__builtin_popcount(rotation_bits) >= GENERATOR_BATCH_MIN_ROTATIONS) {
+			sorted = generator_rotate_batch_avx2(key->data, length, dim, rotation_bits, rkeys);
+		}
+		
+		if (!sorted) sorted = generator_rotate_avx2(key->data, length, dim, rotation_bits, rkeys);
+	} else {
+		generator_rotate_scalar(key->data, length, dim, rotation_bits, rkeys);
+	}
+#else
+	generator_rotate_scalar(key->data, length, dim, rotation_bits, rkeys);
+#endif
 	
 	for (size_t i = 1; i < NUM_ROTATIONS; i++) {
 		if (!(rotation_bits & (1 << i))) continue;
 		
 		Point* kdata = rkeys[i].data;
 		
-		const uint8_t* r = point_get_rotation_data(i);
-		uint8_t r0 = r[0];
-		uint8_t r1 = r[1];
-		uint8_t r2 = r[2];
-		
-		for (size_t j = 0; j < length; j++) {
-			uint8_t* p = pdata[j].data;
-			kdata[j] = POINT_SET_X(p[r0]) + POINT_SET_Y(p[r1]) + POINT_SET_Z(p[r2]);
-		}
-		
-		network_sort(kdata, length, point_compare);
+		if (!sorted) network_sort(kdata, length, point_compare);
 		
 		kdata[length] = bigpoint;
 		rkeys[i].source_index = 0;
 		rkeys[i].length = length;
 		
 	}
+}
+
+// Growing a region by one along an axis adds a constant to each rotated key.
+// Above the key (faces 0-2), component a + 3 (size + 1 - coordinate) grows by one.
+// Below the key (faces 3-5), the key shifts up by one, so component a grows by one.
+// The rotated axis that takes the grown component gets the offset.
+Point generator_get_expand_offset(int face, int rotation) {
+	const uint8_t* r = point_get_rotation_data(rotation);
+	int component = face < 3 ? face + 3 : face - 3;
 	
-	return rotation_bits;
+	if (r[0] == component) return POINT_SET_X(1);
+	if (r[1] == component) return POINT_SET_Y(1);
+	if (r[2] == component) return POINT_SET_Z(1);
+	
+	return 0;
+}
+
+// Moves the smallest of the points from index onwards to index,
+// extending the sorted start of a partially sorted rotated key by one point
+void generator_select_point(Point* points, size_t index, size_t length) {
+	size_t min_index = index;
+	
+	for (size_t i = index + 1; i < length; i++) {
+		if (points[i] < points[min_index]) min_index = i;
+	}
+	
+	Point swap = points[index];
+	points[index] = points[min_index];
+	points[min_index] = swap;
+}
+
+// Finds the lowest first point of the enabled rotations and which rotations start with it.
+// These are an invariant of the set that rules out most rotations before merging.
+void generator_set_first_points(RotationSet* set, size_t length) {
+	Point first_min = POINT_MAX;
+	uint32_t first_mask = 0;
+	
+	for (int j = 0; j < NUM_ROTATIONS; j++) {
+		if (!(set->mask & (1 << j))) continue;
+		
+#ifdef GENERATOR_PARTIAL_SORT
+		if (set->sorted[j] == 0) {
+			generator_select_point(set->keys[j].data, 0, length);
+			set->sorted[j] = 1;
+		}
+#endif
+		Point first = set->keys[j].data[0];
+		
+		if (first < first_min) {
+			first_min = first;
+			first_mask = 0;
+		}
+		
+		if (first == first_min) first_mask |= (1 << j);
+	}
+	
+	set->first_min = first_min;
+	set->first_mask = first_mask;
+}
+
+#ifdef GENERATOR_INHERIT_ROTATIONS
+static uint8_t rotation_products[NUM_ROTATIONS][NUM_ROTATIONS];
+static pthread_once_t rotation_products_once = PTHREAD_ONCE_INIT;
+
+// Fills the table of composed rotations.
+// After rotation b, component a of a point is component f(a) of the original,
+// where f(a) = r_b[a] and f(a + 3) is the reflection of r_b[a].
+// Rotating by j afterwards picks components f(r_j[0]), f(r_j[1]) and f(r_j[2]).
+void generator_rotation_products_init() {
+	for (int b = 0; b < NUM_ROTATIONS; b++) {
+		const uint8_t* rb = point_get_rotation_data(b);
+		uint8_t f[6];
+		
+		for (int a = 0; a < 3; a++) {
+			f[a] = rb[a];
+			f[a + 3] = (rb[a] + 3) % 6;
+		}
+		
+		for (int j = 0; j < NUM_ROTATIONS; j++) {
+			const uint8_t* rj = point_get_rotation_data(j);
+			
+			for (int m = 0; m < NUM_ROTATIONS; m++) {
+				const uint8_t* rm = point_get_rotation_data(m);
+				
+				if (rm[0] == f[rj[0]] && rm[1] == f[rj[1]] && rm[2] == f[rj[2]]) {
+					rotation_products[j][b] = m;
+					break;
+				}
+			}
+		}
+	}
+}
+
+// Builds the inside set of a key from the rotation sets of its parent.
+// The key is the parent grown in the region of a parent set and then rotated by b,
+// so its rotation j is the parent's rotation j after b, with the added point merged in.
+// Rotations the parent set never computed are rotated and sorted as usual.
+void generator_inherit_rotation_set(RotationSet* sets, const Key* key, Point dimensions, const RotationSet* parent_sets, uint8_t origin, GeneratorStats* stats) {
+	pthread_once(&rotation_products_once, generator_rotation_products_init);
+	
+	int face = origin / NUM_ROTATIONS;
+	int b = origin % NUM_ROTATIONS;
+	const RotationSet* parent = &parent_sets[face];
+	const RotationSet* parent_inside = &parent_sets[GENERATOR_INSIDE_SET];
+	
+	RotationSet* inside = &sets[GENERATOR_INSIDE_SET];
+	generator_init_inside_set(inside, dimensions);
+	
+	size_t length = key->length;
+	size_t old_length = length - 1;
+	PointData data = point_get_data(key->data[key->source_index], dimensions);
+	uint32_t missing = 0;
+	
+	for (int j = 0; j < NUM_ROTATIONS; j++) {
+		if (!(inside->computed & (1 << j))) continue;
+		
+		// An expansion set only holds its own mask, but the parent's inside set
+		// may have the rotation, which is the same points before the offset
+		int m = rotation_products[j][b];
+		const Point* src;
+		Point offset = 0;
+		
+		if (parent->computed & (1 << m)) {
+			src = parent->keys[m].data;
+		} else if (face != GENERATOR_INSIDE_SET && (parent_inside->computed & (1 << m))) {
+			src = parent_inside->keys[m].data;
+			offset = generator_get_expand_offset(face, m);
+		} else {
+			missing |= (1 << j);
+			continue;
+		}
+		
+		Point added = point_rotate(data, j);
+		Point* dest = inside->keys[j].data;
+		size_t k = 0;
+		
+		while (k < old_length && src[k] + offset < added) {
+			dest[k] = src[k] + offset;
+			k++;
+		}
+		
+		dest[k] = added;
+		
+		for (; k < old_length; k++) {
+			dest[k + 1] = src[k] + offset;
+		}
+		
+		dest[length] = POINT_MAX;
+		inside->keys[j].source_index = 0;
+		inside->keys[j].length = length;
+	}
+	
+	if (missing) generator_rotate_keys(key, length, dimensions, missing, inside->keys);
+	
+	stats->inherited_rotations += __builtin_popcount(inside->computed & ~missing);
+	stats->recomputed_rotations += __builtin_popcount(missing);
+	
+	inside->ready = 1;
+	generator_set_first_points(inside, length);
+}
+#endif
+
+// Marks every rotation set as not computed yet
+void generator_reset_rotation_sets(RotationSet* sets) {
+	for (int i = 0; i < GENERATOR_NUM_SETS; i++) sets[i].ready = 0;
+}
+
+// Sets up the masks of the inside set. It computes the rotations
+// of its own mask and of every expansion region's mask.
+void generator_init_inside_set(RotationSet* inside, Point dimensions) {
+	inside->dim = dimensions;
+	inside->mask = generator_get_rotation_mask(dimensions);
+	inside->rotated_dim = point_rotate_dimensions(dimensions, __builtin_ctz(inside->mask));
+	inside->computed = inside->mask;
+	
+	for (int i = 0; i < 6; i++) {
+		inside->computed |= generator_get_rotation_mask(get_expand_dimensions(dimensions, i));
+	}
+}
+
+// Returns the rotation set for a face, or the inside set for face -1.
+// The set is computed on first use, so regions without candidates cost nothing.
+// Expansion sets are built from the sorted inside rotations with one add pass.
+// A uniform offset keeps the points sorted, so no expansion set needs sorting.
+RotationSet* generator_get_rotation_set(RotationSet* sets, const Key* key, Point dimensions, int face) {
+	int index = face < 0 ? GENERATOR_INSIDE_SET : face;
+	RotationSet* set = &sets[index];
+	
+	if (set->ready) return set;
+	
+	size_t length = key->length;
+	RotationSet* inside = &sets[GENERATOR_INSIDE_SET];
+	
+	// Every face has candidates, so the inside set computes the rotations
+	// of all regions in one pass
+	if (!inside->ready) {
+		generator_init_inside_set(inside, dimensions);
+		generator_rotate_keys(key, length, dimensions, inside->computed, inside->keys);
+		inside->ready = 1;
+		
+#ifdef GENERATOR_PARTIAL_SORT
+		// Only the original key starts out sorted
+		for (int j = 0; j < NUM_ROTATIONS; j++) inside->sorted[j] = 0;
+		inside->sorted[0] = length;
+#endif
+		
+		generator_set_first_points(inside, length);
+	}
+	
+	if (face < 0) return inside;
+	
+	set->dim = get_expand_dimensions(dimensions, face);
+	set->mask = generator_get_rotation_mask(set->dim);
+	set->rotated_dim = point_rotate_dimensions(set->dim, __builtin_ctz(set->mask));
+	
+	for (int j = 0; j < NUM_ROTATIONS; j++) {
+		if (!(set->mask & (1 << j))) continue;
+		
+		Point offset = generator_get_expand_offset(face, j);
+		const Point* src = inside->keys[j].data;
+		Point* dest = set->keys[j].data;
+		
+		for (size_t i = 0; i < length; i++) {
+			dest[i] = src[i] + offset;
+		}
+		
+		dest[length] = POINT_MAX;
+		set->keys[j].source_index = 0;
+		set->keys[j].length = length;
+		
+#ifdef GENERATOR_PARTIAL_SORT
+		// The offset keeps the order, so whatever the inside key had sorted stays sorted
+		set->sorted[j] = inside->sorted[j];
+#endif
+	}
+	
+	set->computed = set->mask;
+	set->ready = 1;
+	
+	generator_set_first_points(set, length);
+	
+	return set;
 }
 
-int generator_generate(Key key, size_t new_length, Key* output, uint8_t* spacemap) {
+// Returns a mask of the rotations other than the identity that map the key onto itself,
+// found by comparing the inside rotations against the key
+uint32_t generator_get_symmetry_mask(RotationSet* inside, const Key* key) {
+	size_t length = key->length;
+	uint32_t symmetry_mask = 0;
+	
+	for (int j = 1; j < NUM_ROTATIONS; j++) {
+		if (!(inside->mask & (1 << j))) continue;
+		
+		Point* rotation_data = inside->keys[j].data;
+		size_t i = 0;
+		
+		for (; i < length; i++) {
+#ifdef GENERATOR_PARTIAL_SORT
+			if (i == inside->sorted[j]) {
+				generator_select_point(rotation_data, i, length);
+				inside->sorted[j] = i + 1;
+			}
+#endif
+			if (rotation_data[i] != key->data[i]) break;
+		}
+		
+		if (i == length) symmetry_mask |= (1 << j);
+	}
+	
+	return symmetry_mask;
+}
+
+// Keeps only the smallest candidate of each orbit under the key's symmetries.
+// A symmetry maps the key onto itself, so it maps a candidate onto another candidate
+// that grows the same polycube, with the same source index.
+int generator_reduce_candidates(Point* candidates, int n_candidates, Point dim, uint32_t symmetry_mask) {
+	int index = 0;
+	
+	for (int i = 0; i < n_candidates; i++) {
+		Point candidate = candidates[i];
+		PointData data = point_get_data(candidate, dim);
+		int smallest = 1;
+		
+		for (int j = 1; j < NUM_ROTATIONS; j++) {
+			if (!(symmetry_mask & (1 << j))) continue;
+			
+			if (point_rotate(data, j) < candidate) {
+				smallest = 0;
+				break;
+			}
+		}
+		
+		if (smallest) {
+			candidates[index] = candidate;
+			index++;
+		}
+	}
+	
+	return index;
+}
+
+// Expands a key by every candidate, writing the canonical keys to the output.
+// The rotation sets are owned by the caller and must be reset for a new key,
+// unless they were already filled for it by inheriting them from its parent.
+int generator_generate(const Key* key, Point dimensions, size_t new_length, KeyList* output, uint8_t* spacemap, RotationSet* sets, GeneratorStats* stats) {
 	int output_index = 0;
 	size_t old_length = new_length - 1;
 	int n_candidates = old_length * 6;
@@ -153,105 +521,166 @@ int generator_generate(Key key, size_t new_length, Key* output, uint8_t* spacema
 	// Generate initial candidates from existing key faces
 	n_candidates = generator_create_candidates(key, old_length, candidates, spacemap);
 	
-	// Generate all relevant rotated keys for inside dimensions
-	Point dimensions = key_get_dimensions(key);
-	Key rotations_inside[NUM_ROTATIONS];
-	uint32_t rotations_inside_mask = generator_create_rotations(key, old_length, dimensions, rotations_inside);
+	stats->seeds++;
+	stats->candidates += n_candidates;
 	
-	// Generate all relevant rotated keys for the "plus" and "minus" dimension expansion regions
-	// We are guaranteed to use these keys because we have at least one valid candidate on each region
-	Key rotations_expand[6][NUM_ROTATIONS];
-	uint32_t rotations_expand_mask[6];
-	for (int i = 0; i < 6; i++) {
-		Key offset_key = key_get_offset(key, i);
-		Point expand_dim = get_expand_dimensions(dimensions, i);
-		rotations_expand_mask[i] = generator_create_rotations(offset_key, old_length, expand_dim, rotations_expand[i]);
+	// Rotated keys for the inside dimensions and for the "plus" and "minus"
+	// dimension expansion regions are computed as candidates first need them
+	
+	// A symmetric seed grows the same polycube from every candidate of an orbit,
+	// so only one candidate per orbit is merged
+	RotationSet* inside = generator_get_rotation_set(sets, key, dimensions, -1);
+	uint32_t symmetry_mask = generator_get_symmetry_mask(inside, key);
+	if (symmetry_mask) {
+		n_candidates = generator_reduce_candidates(candidates, n_candidates, dimensions, symmetry_mask);
+		stats->symmetric_seeds++;
 	}
 	
+	stats->orbit_candidates += n_candidates;
+	uint64_t rotations = 0;
+	uint64_t merged_rotations = 0;
+	
+	// Two buffers for the merged keys: the best one so far and the one being built.
+	// An improvement only swaps the buffers, and the best is copied out once per candidate.
+	Point merged[2][new_length];
+	
 	// Iterate through candidates:
-	Key max_key = key_get_comparison_maximum(new_length);
 	for (size_t i = 0; i < n_candidates; i++) {
 		Point candidate = candidates[i];
 		int face = get_expand_face(candidate, dimensions);
 		
-		uint32_t candidate_rotations_mask;
-		Key* candidate_rotations;
-		Point candidate_dim;
+		RotationSet* set = generator_get_rotation_set(sets, key, dimensions, face);
+		uint32_t candidate_rotations_mask = set->mask;
+		Key* candidate_rotations = set->keys;
+		Point candidate_dim = set->dim;
 		
-		if (face == -1) {
-			candidate_rotations_mask = rotations_inside_mask;
-			candidate_rotations = rotations_inside;
-			candidate_dim = dimensions;
-		} else {
-			candidate_rotations_mask = rotations_expand_mask[face];
-			candidate_rotations = rotations_expand[face];
-			candidate_dim = get_expand_dimensions(dimensions, face);
-			
-			// If this is a zero indexed face, we need to increase the candidate index 
-			// to match the bounds (minimum of 1 in all dimensions)
-			if (face > 2) {
-				candidate = point_get_offset(candidate, face - 3);
-			}
+		// If this is a zero indexed face, we need to increase the candidate index 
+		// to match the bounds (minimum of 1 in all dimensions)
+		if (face > 2) {
+			candidate = point_get_offset(candidate, face - 3);
 		}
 		
-		// For each rotated key:
-		Key min_key = max_key;
-		Key current_key;
-		current_key.length = new_length;
+		// For each rotated key, tracking the best rotation by index:
+		Point* best = merged[0];
+		Point* current = merged[1];
+		int best_rotation = -1;
+		uint8_t best_source_index = 0;
 		PointData data = point_get_data(candidate, candidate_dim);
 		for (int j = 0; j < NUM_ROTATIONS; j++) {
 			if (!(candidate_rotations_mask & (1 << j))) continue;
 			
 			// Generate candidate rotated to relevant rotation
 			Point candidate_rotated = point_rotate(data, j);
+			rotations++;
+			
+			// The rotations starting with the set's lowest first point merge to keys
+			// starting no higher than it, so a rotation starting above it can only
+			// be minimal if the candidate takes the first place
+			if (candidate_rotated > set->first_min && !(set->first_mask & (1 << j))) continue;
+			merged_rotations++;
+			
 			size_t k = 0;
 			int placed = 0;
-			int found = 0;
+			int found = best_rotation < 0;
 			int greater = 0;
-			Key candidate_rotation = candidate_rotations[j];
+			uint8_t source_index = 0;
+			Point* rotation_data = candidate_rotations[j].data;
 			
 			// Check if rotation key with candidate will be the minimum new rotated key
 			// Merge the candidate into the sorted point stream in the process
 			for(size_t n = 0; n < new_length; n++) {
-				Point next = candidate_rotation.data[k];
+#ifdef GENERATOR_PARTIAL_SORT
+				// Sort the rotated key only as far as the merge reaches;
+				// a rotation that loses early never orders the rest of its points
+				if (k == set->sorted[j] && k < old_length) {
+					generator_select_point(rotation_data, k, old_length);
+					set->sorted[j] = k + 1;
+				}
+#endif
+				Point next = rotation_data[k];
 				size_t inc_k = 1;
 				if (!placed) {
 					if (candidate_rotated < next || k == old_length) {
 						next = candidate_rotated;
 						placed = 1;
 						inc_k = 0;
-						current_key.source_index = n;
+						source_index = n;
 					}
 				}
 				
-				int result = (next - min_key.data[n]);
-				
-				if (result > 0 && !found) {
-					greater = 1;
-					break;
+				if (!found) {
+					int result = (next - best[n]);
+					
+					if (result > 0) {
+						greater = 1;
+						break;
+					}
+					
+					found = (result < 0);
 				}
 				
-				found = found || (result < 0);
-				
-				current_key.data[n] = next;
+				current[n] = next;
 				k += inc_k;
 			}
 			
 			// Keep equal keys with higher source_index values
 			// Required for making sure we have the proper output keys
-			if (found || (!greater && current_key.source_index > min_key.source_index)) {
-				min_key = current_key;
+			if (found || (!greater && source_index > best_source_index)) {
+				Point* swap = best;
+				best = current;
+				current = swap;
+				best_rotation = j;
+				best_source_index = source_index;
 			}
 		}
 		
-		// Return minimum new rotated key
-		output[output_index] = min_key;
+		// Return minimum new rotated key, along with its dimensions in that rotation
+		key_list_set_points(output, output_index, best, best_source_index, set->rotated_dim);
+#ifdef GENERATOR_INHERIT_ROTATIONS
+		output->origins[output_index] = (set - sets) * NUM_ROTATIONS + best_rotation;
+#endif
 		output_index++;
 	}
 	
+	output->count = output_index;
+	
+	stats->rotations += rotations;
+	stats->merged_rotations += merged_rotations;
+	
 	return output_index;
 }
 
+void generator_stats_add(GeneratorStats* total, const GeneratorStats* stats) {
+	total->seeds += stats->seeds;
+	total->symmetric_seeds += stats->symmetric_seeds;
+	total->candidates += stats->candidates;
+	total->orbit_candidates += stats->orbit_candidates;
+	total->rotations += stats->rotations;
+	total->merged_rotations += stats->merged_rotations;
+	total->inherited_rotations += stats->inherited_rotations;
+	total->recomputed_rotations += stats->recomputed_rotations;
+}
+
+// Prints the counters along with the share of the work each step removed
+void generator_stats_print(const GeneratorStats* stats) {
+	double seeds = stats->seeds ? stats->seeds : 1;
+	double candidates = stats->candidates ? stats->candidates : 1;
+	double rotations = stats->rotations ? stats->rotations : 1;
+	
+	printf("%lld seeds, %lld symmetric (%.2f%%)\n", (long long int)stats->seeds,
+		(long long int)stats->symmetric_seeds, 100.0 * stats->symmetric_seeds / seeds);
+	printf("%lld candidates, %lld after orbit pruning (%.2f%% pruned)\n", (long long int)stats->candidates,
+		(long long int)stats->orbit_candidates, 100.0 * (stats->candidates - stats->orbit_candidates) / candidates);
+	printf("%lld rotations, %lld merged after the first point check (%.2f%% pruned)\n", (long long int)stats->rotations,
+		(long long int)stats->merged_rotations, 100.0 * (stats->rotations - stats->merged_rotations) / rotations);
+	
+	uint64_t seed_rotations = stats->inherited_rotations + stats->recomputed_rotations;
+	if (seed_rotations > 0) {
+		printf("%lld seed rotations inherited from parents, %lld recomputed (%.2f%% inherited)\n", (long long int)stats->inherited_rotations,
+			(long long int)stats->recomputed_rotations, 100.0 * stats->inherited_rotations / seed_rotations);
+	}
+}
+
 
 
 
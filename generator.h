@@ -5,14 +5,62 @@
 
 #include "point.h"
 #include "key.h"
+#include "key_list.h"
+
+#define GENERATOR_NUM_ROTATIONS 24
+#define GENERATOR_INSIDE_SET 6
+#define GENERATOR_NUM_SETS 7
+
+#if defined(GENERATOR_INHERIT_ROTATIONS) && defined(GENERATOR_PARTIAL_SORT)
+#error "Inheriting rotation sets needs the parent rotations fully sorted"
+#endif
+
+// The rotated keys of a seed for one region: inside its dimensions,
+// or expanded past one of its six faces.
+// Sets are only computed the first time a candidate needs them,
+// and expansion sets are derived from the inside set.
+typedef struct {
+	Key keys[GENERATOR_NUM_ROTATIONS];
+	uint32_t mask; // enabled rotations
+	uint32_t computed; // rotations holding valid keys, which may include more than the mask
+	Point dim;
+	Point rotated_dim; // dimensions after any enabled rotation, which the mask makes all equal
+	int ready;
+	Point first_min; // lowest first point of the enabled rotations
+	uint32_t first_mask; // enabled rotations starting with that point
+#ifdef GENERATOR_PARTIAL_SORT
+	uint8_t sorted[GENERATOR_NUM_ROTATIONS]; // leading points of each rotated key already in order
+#endif
+} RotationSet;
+
+// Counters for how much work the generator did and how much it skipped
+typedef struct {
+	uint64_t seeds;
+	uint64_t symmetric_seeds;
+	uint64_t candidates; // candidates found on the faces of the seeds
+	uint64_t orbit_candidates; // candidates left after keeping one per orbit
+	uint64_t rotations; // enabled rotations over all remaining candidates
+	uint64_t merged_rotations; // rotations left to merge after the first point check
+	uint64_t inherited_rotations; // seed rotations merged from the parent's rotations
+	uint64_t recomputed_rotations; // seed rotations the parent didn't have
+} GeneratorStats;
 
-Point get_expand_dim(Point dim, int face);
 int get_expand_face(Point point, Point dim);
-uint32_t generator_create_rotations(Key key, size_t length, Point dim, Key* rkeys);
-int generator_generate(Key key, size_t new_length, Key* output, uint8_t* spacemap);
+uint32_t generator_get_rotation_mask(Point dim);
+uint32_t generator_create_rotations(const Key* key, size_t length, Point dim, Key* rkeys);
+void generator_rotate_keys(const Key* key, size_t length, Point dim, uint32_t rotation_bits, Key* rkeys);
+Point generator_get_expand_offset(int face, int rotation);
+void generator_select_point(Point* points, size_t index, size_t length);
+void generator_reset_rotation_sets(RotationSet* sets);
+void generator_inherit_rotation_set(RotationSet* sets, const Key* key, Point dimensions, const RotationSet* parent_sets, uint8_t origin, GeneratorStats* stats);
+void generator_init_inside_set(RotationSet* inside, Point dimensions);
+RotationSet* generator_get_rotation_set(RotationSet* sets, const Key* key, Point dimensions, int face);
+uint32_t generator_get_symmetry_mask(RotationSet* inside, const Key* key);
+int generator_reduce_candidates(Point* candidates, int n_candidates, Point dim, uint32_t symmetry_mask);
+void generator_set_first_points(RotationSet* set, size_t length);
+int generator_generate(const Key* key, Point dimensions, size_t new_length, KeyList* output, uint8_t* spacemap, RotationSet* sets, GeneratorStats* stats);
 
-int key_has_larger_single_neighbor(Key key, uint8_t* places);
-int key_is_connected_without(Key key, int index, uint8_t* places);
-int key_has_larger_connected_source(Key key, uint8_t* places);
+void generator_stats_add(GeneratorStats* total, const GeneratorStats* stats);
+void generator_stats_print(const GeneratorStats* stats);
 
 #endif
@@ -0,0 +1,223 @@
+#include <pthread.h>
+
+#include "generator_avx2.h"
+#include "sorting_networks.h"
+
+#ifdef CPU_X86_SIMD
+
+#include "point_avx2.h"
+#include "network_sort_avx2.h"
+
+#define NUM_ROTATIONS 24
+#define BATCH_MAX_LENGTH 32
+
+// Byte shuffle controls that pick one PointData component per rotation lane.
+// Rotations 0-15 use the 256 bit control, rotations 16-23 the 128 bit one.
+typedef struct {
+	uint8_t lower[3][32];
+	uint8_t upper[3][16];
+} __attribute__((aligned(32))) BatchControl;
+
+static BatchControl batch_control;
+static pthread_once_t batch_once = PTHREAD_ONCE_INIT;
+
+void generator_batch_init() {
+	for (int i = 0; i < NUM_ROTATIONS; i++) {
+		const uint8_t* r = point_get_rotation_data(i);
+		
+		for (int k = 0; k < 3; k++) {
+			// Each 128 bit half shuffles its own copy of the components, so lane i reads bytes 2i and 2i+1
+			uint8_t* control = i < 16 ? &batch_control.lower[k][i * 2] : &batch_control.upper[k][(i - 16) * 2];
+			control[0] = r[k];
+			control[1] = 0x80;
+		}
+	}
+}
+
+// Rotates every point of a key for all enabled rotations except the identity.
+// Each of the six PointData components is held for 16 points per register,
+// so every rotation is just a choice of three component registers.
+// If there is a sorting network for this length and it is long enough to beat
+// the scalar networks, the rotated points are sorted before leaving the registers
+// and the function returns 1.
+// Otherwise the rotated points are written straight into each rotated key, unsorted.
+__attribute__((target("avx2")))
+int generator_rotate_avx2(const Point* points, size_t length, Point dim, uint32_t rotation_bits, Key* rkeys) {
+	__m256i v[2];
+	point_load_avx2(points, length, v);
+	
+	__m256i mask = _mm256_set1_epi16(POINT_MASK_X);
+	__m256i dx = _mm256_set1_epi16(POINT_GET_X(dim) + 1);
+	__m256i dy = _mm256_set1_epi16(POINT_GET_Y(dim) + 1);
+	__m256i dz = _mm256_set1_epi16(POINT_GET_Z(dim) + 1);
+	
+	__m256i components[6][2];
+	for (int h = 0; h < 2; h++) {
+		components[0][h] = _mm256_and_si256(v[h], mask);
+		components[1][h] = _mm256_and_si256(_mm256_srli_epi16(v[h], 5), mask);
+		components[2][h] = _mm256_and_si256(_mm256_srli_epi16(v[h], 10), mask);
+		components[3][h] = _mm256_sub_epi16(dx, components[0][h]);
+		components[4][h] = _mm256_sub_epi16(dy, components[1][h]);
+		components[5][h] = _mm256_sub_epi16(dz, components[2][h]);
+	}
+	
+	// Partial sorting leaves the ordering to the merge loop
+#ifdef GENERATOR_PARTIAL_SORT
+	int sorted = 0;
+#else
+	int sorted = length >= NETWORK_SORT_AVX2_MIN_REGISTER_LENGTH;
+#endif
+	
+	for (int i = 1; i < NUM_ROTATIONS; i++) {
+		if (!(rotation_bits & (1 << i))) continue;
+		
+		const uint8_t* r = point_get_rotation_data(i);
+		
+		__m256i result[2];
+		for (int h = 0; h < 2; h++) {
+			result[h] = _mm256_or_si256(components[r[0]][h], _mm256_slli_epi16(components[r[1]][h], 5));
+			result[h] = _mm256_or_si256(result[h], _mm256_slli_epi16(components[r[2]][h], 10));
+		}
+		
+		if (sorted) sorted = network_sort_avx2_registers(result, length);
+		
+		// Lanes past the key length land in unused space of the key data
+		point_store_avx2(rkeys[i].data, length, result);
+	}
+	
+	return sorted;
+}
+
+// Transposes an 8x8 block of points, turning rows into columns
+__attribute__((target("avx2")))
+static inline void generator_transpose8_avx2(__m128i* a) {
+	__m128i b[8], c[8];
+	
+	for (int i = 0; i < 4; i++) {
+		b[i * 2] = _mm_unpacklo_epi16(a[i * 2], a[i * 2 + 1]);
+		b[i * 2 + 1] = _mm_unpackhi_epi16(a[i * 2], a[i * 2 + 1]);
+	}
+	
+	for (int i = 0; i < 2; i++) {
+		c[i * 4] = _mm_unpacklo_epi32(b[i * 4], b[i * 4 + 2]);
+		c[i * 4 + 1] = _mm_unpackhi_epi32(b[i * 4], b[i * 4 + 2]);
+		c[i * 4 + 2] = _mm_unpacklo_epi32(b[i * 4 + 1], b[i * 4 + 3]);
+		c[i * 4 + 3] = _mm_unpackhi_epi32(b[i * 4 + 1], b[i * 4 + 3]);
+	}
+	
+	for (int i = 0; i < 4; i++) {
+		a[i * 2] = _mm_unpacklo_epi64(c[i], c[i + 4]);
+		a[i * 2 + 1] = _mm_unpackhi_epi64(c[i], c[i + 4]);
+	}
+}
+
+#define BATCH_SWAP(a, b) { \
+	__m256i t = lower[a]; \
+	lower[a] = _mm256_min_epu16(t, lower[b]); \
+	lower[b] = _mm256_max_epu16(t, lower[b]); \
+	__m128i u = upper[a]; \
+	upper[a] = _mm_min_epu16(u, upper[b]); \
+	upper[b] = _mm_max_epu16(u, upper[b]); \
+}
+
+#define BATCH_NETWORK(n) case n: NETWORK##n(BATCH_SWAP) break;
+#define BATCH_HAS_NETWORK(n) case n:
+
+// Rotates and sorts all 24 rotations of a key at once.
+// Point j of every rotation is held in one structure of arrays row,
+// with rotation r in 16 bit lane r (0-15 in a 256 bit register, 16-23 in a 128 bit one).
+// Rows are sorted against each other by a single vertical sorting network,
+// then transposed back so each enabled rotation lands sorted in its key.
+// Returns 0 without touching the keys if there is no network for this length.
+__attribute__((target("avx2")))
+int generator_rotate_batch_avx2(const Point* points, size_t length, Point dim, uint32_t rotation_bits, Key* rkeys) {
+	switch (length) {
+		SORTING_NETWORKS(BATCH_HAS_NETWORK)
+			break;
+		default:
+			return 0;
+	}
+	
+	pthread_once(&batch_once, generator_batch_init);
+	
+	__m256i lower[BATCH_MAX_LENGTH];
+	__m128i upper[BATCH_MAX_LENGTH];
+	
+	__m256i control_lower[3];
+	__m128i control_upper[3];
+	for (int k = 0; k < 3; k++) {
+		control_lower[k] = _mm256_load_si256((const __m256i*) batch_control.lower[k]);
+		control_upper[k] = _mm_load_si128((const __m128i*) batch_control.upper[k]);
+	}
+	
+	uint64_t dx = POINT_GET_X(dim) + 1;
+	uint64_t dy = POINT_GET_Y(dim) + 1;
+	uint64_t dz = POINT_GET_Z(dim) + 1;
+	
+	// Build one row per point from its six PointData components packed into bytes
+	for (size_t j = 0; j < length; j++) {
+		uint64_t x = POINT_GET_X(points[j]);
+		uint64_t y = POINT_GET_Y(points[j]);
+		uint64_t z = POINT_GET_Z(points[j]);
+		uint64_t packed = x | (y << 8) | (z << 16) | ((dx - x) << 24) | ((dy - y) << 32) | ((dz - z) << 40);
+		
+		__m256i table = _mm256_set1_epi64x(packed);
+		__m128i table_upper = _mm256_castsi256_si128(table);
+		
+		lower[j] = _mm256_or_si256(
+			_mm256_shuffle_epi8(table, control_lower[0]),
+			_mm256_or_si256(
+				_mm256_slli_epi16(_mm256_shuffle_epi8(table, control_lower[1]), 5),
+				_mm256_slli_epi16(_mm256_shuffle_epi8(table, control_lower[2]), 10)));
+		upper[j] = _mm_or_si128(
+			_mm_shuffle_epi8(table_upper, control_upper[0]),
+			_mm_or_si128(
+				_mm_slli_epi16(_mm_shuffle_epi8(table_upper, control_upper[1]), 5),
+				_mm_slli_epi16(_mm_shuffle_epi8(table_upper, control_upper[2]), 10)));
+	}
+	
+	switch (length) {
+		SORTING_NETWORKS(BATCH_NETWORK)
+	}
+	
+	// Pad the rows up to a whole block; the padding lands past the key length
+	size_t rows = (length + 7) & ~7;
+	for (size_t j = length; j < rows; j++) {
+		lower[j] = _mm256_setzero_si256();
+		upper[j] = _mm_setzero_si128();
+	}
+	
+	// Transpose 8 rows by 8 rotations at a time.
+	// A block may write up to data[31], so the block holding point 24 and up
+	// would run past the end of the key and is written point by point instead.
+	for (size_t j0 = 0; j0 < rows; j0 += 8) {
+		for (int r0 = 0; r0 < NUM_ROTATIONS; r0 += 8) {
+			if (!(((rotation_bits & ~1u) >> r0) & 0xFF)) continue;
+			
+			__m128i block[8];
+			for (int j = 0; j < 8; j++) {
+				if (r0 < 16) block[j] = r0 ? _mm256_extracti128_si256(lower[j0 + j], 1) : _mm256_castsi256_si128(lower[j0 + j]);
+				else block[j] = upper[j0 + j];
+			}
+			
+			generator_transpose8_avx2(block);
+			
+			for (int r = 0; r < 8; r++) {
+				int i = r0 + r;
+				if (i == 0 || !(rotation_bits & (1 << i))) continue;
+				
+				if (j0 + 8 <= 31) {
+					_mm_storeu_si128((__m128i*) &rkeys[i].data[j0], block[r]);
+				} else {
+					uint16_t column[8];
+					_mm_storeu_si128((__m128i*) column, block[r]);
+					for (size_t j = j0; j < length; j++) rkeys[i].data[j] = column[j - j0];
+				}
+			}
+		}
+	}
+	
+	return 1;
+}
+
+#endif
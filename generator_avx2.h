@@ -0,0 +1,15 @@
+#include <stdint.h>
+
+#include "cpu.h"
+#include "point.h"
+#include "key.h"
+
+#ifndef GENERATOR_AVX2_H
+#define GENERATOR_AVX2_H
+
+#ifdef CPU_X86_SIMD
+int generator_rotate_avx2(const Point* points, size_t length, Point dim, uint32_t rotation_bits, Key* rkeys);
+int generator_rotate_batch_avx2(const Point* points, size_t length, Point dim, uint32_t rotation_bits, Key* rkeys);
+#endif
+
+#endif
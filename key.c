@@ -1,11 +1,12 @@
 #include <string.h>
 
 #include "key.h"
+#include "bitboard.h"
 
 // This function captures the dimension size by finding
 // the maximum component in every direction of the key
-Point key_get_dimensions(Key key) {
-	Point* k = key.data;
+Point key_get_dimensions(const Key* key) {
+	const Point* k = key->data;
 	Point d[3];
 	d[0] = 0;
 	d[1] = 0;
@@ -16,7 +17,7 @@ Point key_get_dimensions(Key key) {
 	mask[1] = POINT_MASK_Y;
 	mask[2] = POINT_MASK_Z;
 	
-	for (int i = 0; i < key.length; i++) {
+	for (int i = 0; i < key->length; i++) {
 		for (int j = 0; j < 3; j++) {
 			Point value = k[i] & mask[j];
 			if (value > d[j]) {
@@ -28,52 +29,35 @@ Point key_get_dimensions(Key key) {
 	return d[0] + d[1] + d[2];
 }
 
-// Keys need to be adjusted if using higher face numbers,
-// which correspond to point coordinates outside the region
-Key key_get_offset(Key key, uint8_t face) {
-	if (face < 3) return key;
-	
-	Key retval = key;
-	
-	for (size_t i = 0; i < key.length; i++) {
-		retval.data[i] = point_get_offset(key.data[i], face - 3);
-	}
-	
-	return retval;
-}
-
-// Returns the maximum possible key for the current length
-// Used for initial comparison when comparing rotations
-Key key_get_comparison_maximum(uint8_t length) {
-	Point p = POINT_MAX;
-	
-	Key retval;
-	retval.length = length;
-	
-	for (size_t i = 0; i < length; i++) {
-		retval.data[i] = p;
-	}
-	
-	return retval;
-}
-
-
 // This is the faster function to determine if a key was generated
 // from the maximum possible added point ("source_index").
 // Points with single neighbors are guaranteed to not be considered
 // "cut points" of the polycube.
 // If this function finds such a point, the result will be thrown out
-int key_has_larger_single_neighbor(Key key, uint8_t* places) {
+// Neighbors are counted on the bitboard if the key fits, otherwise on the places map
+int key_has_larger_single_neighbor(const Key* key, uint8_t* places) {
 	int retval = 0;
 	const int* offsets_lut = point_get_offsets_lut();
 	
-	for (uint8_t i = 0; i < key.length; i++) {
-		places[key.data[i]] = 1;
+	// Nothing to check if the added point is already the last one
+	if (key->source_index + 1 >= key->length) return 0;
+	
+	Bitboard board;
+	if (bitboard_fill(&board, key->data, key->length)) {
+		for (uint8_t i = key->length - 1; i > key->source_index; i--) {
+			if (bitboard_count_neighbors(&board, key->data[i]) == 1) return 1;
+		}
+		
+		return 0;
+	}
+	
+	for (uint8_t i = 0; i < key->length; i++) {
+		places[key->data[i]] = 1;
 	}
 	
-	for (uint8_t i = key.length - 1; i > key.source_index; i--) {
+	for (uint8_t i = key->length - 1; i > key->source_index; i--) {
 		uint8_t count = 0;
-		int ptbasekey = key.data[i];
+		int ptbasekey = key->data[i];
 		
 		for (uint8_t f = 0; f < 6; f++) {
 			count += places[ptbasekey + offsets_lut[f]];
@@ -85,8 +69,8 @@ int key_has_larger_single_neighbor(Key key, uint8_t* places) {
 		}
 	}
 	
-	for (uint8_t i = 0; i < key.length; i++) {
-		places[key.data[i]] = 0;
+	for (uint8_t i = 0; i < key->length; i++) {
+		places[key->data[i]] = 0;
 	}
 	
 	return retval;
@@ -98,20 +82,20 @@ int key_has_larger_single_neighbor(Key key, uint8_t* places) {
 // and tries to traverse the entire cube.
 // If it fails to find all points, the caller will move to the next
 // alternative "source_index".
-int key_is_connected_without(Key key, int index, uint8_t* places) {
-	int source_length = key.length - 1;
+int key_is_connected_without(const Key* key, int index, uint8_t* places) {
+	int source_length = key->length - 1;
 	const int* offsets_lut = point_get_offsets_lut();
 	
 	uint8_t point_index = 1;
 	int point_keys[source_length];
-	point_keys[0] = key.data[0];
+	point_keys[0] = key->data[0];
 	int ptkey = 0;
 	
-	for (uint8_t i = 1; i < key.length; i++) {
-		places[key.data[i]] = 1;
+	for (uint8_t i = 1; i < key->length; i++) {
+		places[key->data[i]] = 1;
 	}
 	
-	places[key.data[index]] = 0;
+	places[key->data[index]] = 0;
 	
 	for (uint8_t i = 0; i < source_length - 1; i++) {
 		
@@ -138,20 +122,105 @@ int key_is_connected_without(Key key, int index, uint8_t* places) {
 	
 	// In case we don't fully traverse the cube, we need to make sure
 	// the map is reset for the next check
-	for (uint8_t i = 0; i < key.length; i++) {
-		places[key.data[i]] = 0;
+	for (uint8_t i = 0; i < key->length; i++) {
+		places[key->data[i]] = 0;
 	}
 	
 	return point_index >= source_length;
 }
 
+// Finds every point that can be removed while keeping the polycube connected.
+// This is a single depth first traversal in the style of Hopcroft-Tarjan
+// articulation points. Instead of tracking the lowest reachable discovery order,
+// each subtree tracks a bitmask of the ancestors it can reach through back edges.
+// A parent is a cut point if one of its subtrees can't reach above it.
+// Bit i of the result is set if point i is not a cut point.
+uint32_t key_get_removable_mask(const Key* key, uint8_t* places) {
+	uint8_t length = key->length;
+	const int* offsets_lut = point_get_offsets_lut();
+	
+	uint32_t neighbors[length];
+	uint32_t reach[length]; // ancestors reachable from the subtree
+	uint8_t stack[length];
+	
+	// The map holds index + 1 so that empty places read as zero
+	for (uint8_t i = 0; i < length; i++) {
+		places[key->data[i]] = i + 1;
+	}
+	
+	for (uint8_t i = 0; i < length; i++) {
+		uint32_t mask = 0;
+		int ptbasekey = key->data[i];
+		
+		// Empty places shift the bit out entirely
+		for (uint8_t f = 0; f < 6; f++) {
+			mask |= (1u << places[ptbasekey + offsets_lut[f]]) >> 1;
+		}
+		
+		neighbors[i] = mask;
+	}
+	
+	for (uint8_t i = 0; i < length; i++) {
+		places[key->data[i]] = 0;
+	}
+	
+	uint32_t visited = 1;
+	uint32_t path = 1; // points on the stack
+	uint32_t cut = 0;
+	int root_children = 0;
+	int top = 0;
+	
+	stack[0] = 0;
+	reach[0] = 0;
+	
+	while (1) {
+		uint8_t v = stack[top];
+		uint32_t next = neighbors[v] & ~visited;
+		
+		if (next) {
+			uint8_t w = __builtin_ctz(next);
+			uint32_t bit = 1u << w;
+			
+			visited |= bit;
+			path |= bit;
+			reach[w] = 0;
+			top++;
+			stack[top] = w;
+			
+			continue;
+		}
+		
+		// All neighbors are visited once the point is finished,
+		// so the back edges are exactly the neighbors still on the stack
+		path &= ~(1u << v);
+		uint32_t r = (reach[v] | neighbors[v]) & path;
+		
+		top--;
+		if (top < 0) break;
+		
+		uint8_t u = stack[top];
+		
+		if (u == 0) root_children++;
+		else if (!(r & ~(1u << u))) cut |= 1u << u;
+		
+		reach[u] |= r;
+	}
+	
+	// The root is only a cut point if the traversal had to branch from it
+	if (root_children > 1) cut |= 1;
+	
+	return ~cut & ((1u << length) - 1);
+}
+
 // Parent slower function to check for candidate alternative "source_index" points.
-// This might not be the most efficient algorithm (such as graph theory methods), but the faster
-// single neighbor check removes most of the slowness from this process
-int key_has_larger_connected_source(Key key, uint8_t* places) {
+// By default this uses the single pass cut point search above.
+// Building with -DKEY_FLOOD_FILL_CHECK restores the original per-index flood fill
+// for comparing counts.
+int key_has_larger_connected_source(const Key* key, uint8_t* places) {
+#ifdef KEY_FLOOD_FILL_CHECK
 	int retval = 0;
 	
-	for (uint8_t i = key.length - 1; i > key.source_index; i--) {
+	for (uint8_t i = key->length - 1; i > key->source_index; i--) {
 		if (key_is_connected_without(key, i, places)) {
 			retval = 1;
 			break;
@@ -159,6 +228,14 @@ int key_has_larger_connected_source(Key key, uint8_t* places) {
 	}
 		
 	return retval;
+#else
+	// Nothing to check if the added point is already the last one
+	if (key->source_index + 1 >= key->length) return 0;
+	
+	uint32_t removable = key_get_removable_mask(key, places);
+	
+	return (removable >> (key->source_index + 1)) != 0;
+#endif
 }
 
 int key_compare(const void* a, const void* b) {
@@ -168,3 +245,37 @@ int key_compare(const void* a, const void* b) {
 	return memcmp(ak->data, bk->data, ak->length << 1);
 }
 
+
+// Hashes a list of points, ignoring anything past the length.
+// Equal keys always hash equal, so the hash can stand in for the key when sorting
+// for duplicates, with a full compare only needed when hashes match.
+uint64_t key_hash_points(const Point* points, size_t length) {
+	uint64_t hash = length;
+	size_t i = 0;
+	
+	for (; i + 4 <= length; i += 4) {
+		uint64_t word;
+		memcpy(&word, &points[i], sizeof(word));
+		
+		hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+		hash ^= hash >> 32;
+	}
+	
+	if (i < length) {
+		uint64_t word = 0;
+		for (size_t j = i; j < length; j++) word |= (uint64_t) points[j] << ((j - i) * 16);
+		
+		hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+		hash ^= hash >> 32;
+	}
+	
+	hash *= 0xD6E8FEB86659FD93ull;
+	hash ^= hash >> 32;
+	
+	return hash;
+}
+
+// Hashes the points of a key, ignoring the source index
+uint64_t key_get_hash(const Key* key) {
+	return key_hash_points(key->data, key->length);
+}
@@ -11,17 +11,16 @@ typedef struct {
 	uint8_t length;
 } Key;
 
-Point key_get_dimensions(Key key);
+Point key_get_dimensions(const Key* key);
 
-Key key_get_offset(Key key, uint8_t face);
-
-Key key_get_comparison_maximum(uint8_t length);
-
-int key_has_larger_single_neighbor(Key key, uint8_t* places);
-int key_is_connected_without(Key key, int index, uint8_t* places);
-int key_has_larger_connected_source(Key key, uint8_t* places);
+int key_has_larger_single_neighbor(const Key* key, uint8_t* places);
+int key_is_connected_without(const Key* key, int index, uint8_t* places);
+uint32_t key_get_removable_mask(const Key* key, uint8_t* places);
+int key_has_larger_connected_source(const Key* key, uint8_t* places);
 
 int key_compare(const void* a, const void* b);
+uint64_t key_hash_points(const Point* points, size_t length);
+uint64_t key_get_hash(const Key* key);
 
 
 #endif
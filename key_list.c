@@ -0,0 +1,128 @@
+#include <string.h>
+
+#include "key_list.h"
+
+KeyList* key_list_create(uint8_t length, uint64_t capacity) {
+	KeyList* retval = calloc(1, sizeof(KeyList));
+	
+	retval->length = length;
+	retval->count = 0;
+	retval->capacity = capacity;
+	retval->points = calloc(capacity * length + KEY_LIST_PADDING, sizeof(Point));
+	retval->source_indexes = calloc(capacity, sizeof(uint8_t));
+	retval->dimensions = calloc(capacity, sizeof(Point));
+	retval->origins = calloc(capacity, sizeof(uint8_t));
+	
+	return retval;
+}
+
+void key_list_destroy(KeyList* list) {
+	if (list == NULL) return;
+	
+	free(list->points);
+	free(list->source_indexes);
+	free(list->dimensions);
+	free(list->origins);
+	free(list);
+}
+
+// Grows the list to hold at least capacity keys, at least doubling it when it grows
+void key_list_reserve(KeyList* list, uint64_t capacity) {
+	if (capacity <= list->capacity) return;
+	
+	if (capacity < list->capacity * 2) capacity = list->capacity * 2;
+	
+	list->points = realloc(list->points, (capacity * list->length + KEY_LIST_PADDING) * sizeof(Point));
+	list->source_indexes = realloc(list->source_indexes, capacity * sizeof(uint8_t));
+	list->dimensions = realloc(list->dimensions, capacity * sizeof(Point));
+	list->origins = realloc(list->origins, capacity * sizeof(uint8_t));
+	
+	list->capacity = capacity;
+}
+
+// Expands a packed key into a full Key.
+// The copy has a fixed size so it compiles to a few wide moves,
+// leaving points of the following keys past the length.
+Key key_list_get(const KeyList* list, uint64_t index) {
+	Key retval;
+	
+	memcpy(retval.data, KEY_LIST_POINTS(list, index), sizeof(retval.data));
+	retval.source_index = list->source_indexes[index];
+	retval.length = list->length;
+	
+	return retval;
+}
+
+// Returns the stored dimensions of a key, measuring them if they were never stored
+Point key_list_get_dimensions(const KeyList* list, uint64_t index) {
+	Point dimensions = list->dimensions[index];
+	
+	if (dimensions == 0) {
+		Key key = key_list_get(list, index);
+		dimensions = key_get_dimensions(&key);
+	}
+	
+	return dimensions;
+}
+
+// Packs points into the list, copying 8 bytes at a time.
+// The last word is aligned to the end of the key so neighbors are left untouched.
+// Dimensions of 0 mark them as unknown.
+void key_list_set_points(KeyList* list, uint64_t index, const Point* points, uint8_t source_index, Point dimensions) {
+	uint8_t* dest = (uint8_t*) KEY_LIST_POINTS(list, index);
+	const uint8_t* src = (const uint8_t*) points;
+	size_t size = list->length * sizeof(Point);
+	
+	if (size < 8) {
+		memcpy(dest, src, size);
+	} else {
+		for (size_t i = 0; i + 8 < size; i += 8) memcpy(dest + i, src + i, 8);
+		memcpy(dest + size - 8, src + size - 8, 8);
+	}
+	
+	list->source_indexes[index] = source_index;
+	list->dimensions[index] = dimensions;
+}
+
+void key_list_set(KeyList* list, uint64_t index, const Key* key) {
+	key_list_set_points(list, index, key->data, key->source_index, 0);
+}
+
+void key_list_push(KeyList* list, const Key* key) {
+	key_list_set(list, list->count, key);
+	list->count++;
+}
+
+// Copies a run of keys between lists of the same length.
+// Packed keys are contiguous, so this is a single copy of points, indexes and dimensions.
+void key_list_copy(KeyList* dest, uint64_t dest_index, const KeyList* src, uint64_t src_index, uint64_t count) {
+	memmove(KEY_LIST_POINTS(dest, dest_index), KEY_LIST_POINTS(src, src_index), count * src->length * sizeof(Point));
+	memmove(&dest->source_indexes[dest_index], &src->source_indexes[src_index], count);
+	memmove(&dest->dimensions[dest_index], &src->dimensions[src_index], count * sizeof(Point));
+	memmove(&dest->origins[dest_index], &src->origins[src_index], count);
+}
+
+// Compares the points of two keys 8 bytes at a time.
+// The padding at the end of the list keeps the last partial word in bounds.
+int key_list_equal(const KeyList* list, uint64_t a, uint64_t b) {
+	const uint8_t* pa = (const uint8_t*) KEY_LIST_POINTS(list, a);
+	const uint8_t* pb = (const uint8_t*) KEY_LIST_POINTS(list, b);
+	size_t size = list->length * sizeof(Point);
+	
+	for (size_t i = 0; i < size; i += 8) {
+		uint64_t wa, wb;
+		memcpy(&wa, pa + i, 8);
+		memcpy(&wb, pb + i, 8);
+		
+		uint64_t diff = wa ^ wb;
+		if (size - i < 8) diff &= (1ull << ((size - i) * 8)) - 1;
+		
+		if (diff) return 0;
+	}
+	
+	return 1;
+}
+
+uint64_t key_list_get_hash(const KeyList* list, uint64_t index) {
+	return key_hash_points(KEY_LIST_POINTS(list, index), list->length);
+}
@@ -0,0 +1,46 @@
+#include <stdint.h>
+
+#include "point.h"
+#include "key.h"
+
+#ifndef KEY_LIST_H
+#define KEY_LIST_H
+
+// Extra points allocated past the last key so a full Key worth of points
+// can be read from any key without leaving the allocation
+#define KEY_LIST_PADDING 32
+
+// Compact storage for many keys of the same length.
+// The points of each key are packed back to back with a stride of the key length,
+// and the source indexes are kept in a separate array.
+// Keys made by the generator also carry their dimensions, so children don't need
+// to measure them again. Keys from anywhere else store 0 until the dimensions are asked for.
+// The origins are always allocated so the layout doesn't depend on build flags,
+// but they are only filled in when rotations are inherited.
+typedef struct {
+	uint8_t length;
+	uint64_t count;
+	uint64_t capacity;
+	Point* points;
+	uint8_t* source_indexes;
+	Point* dimensions;
+	uint8_t* origins; // parent rotation set and rotation each generated key came from, with -DGENERATOR_INHERIT_ROTATIONS
+} KeyList;
+
+#define KEY_LIST_POINTS(list, index) (&(list)->points[(uint64_t) (index) * (list)->length])
+
+KeyList* key_list_create(uint8_t length, uint64_t capacity);
+void key_list_destroy(KeyList* list);
+void key_list_reserve(KeyList* list, uint64_t capacity);
+
+Key key_list_get(const KeyList* list, uint64_t index);
+void key_list_set(KeyList* list, uint64_t index, const Key* key);
+Point key_list_get_dimensions(const KeyList* list, uint64_t index);
+void key_list_set_points(KeyList* list, uint64_t index, const Point* points, uint8_t source_index, Point dimensions);
+void key_list_push(KeyList* list, const Key* key);
+void key_list_copy(KeyList* dest, uint64_t dest_index, const KeyList* src, uint64_t src_index, uint64_t count);
+
+int key_list_equal(const KeyList* list, uint64_t a, uint64_t b);
+uint64_t key_list_get_hash(const KeyList* list, uint64_t index);
+
+#endif
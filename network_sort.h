@@ -3,21 +3,11 @@
 
 #include <stdint.h>
 
+#include "sorting_networks.h"
+
 void network_sort(uint16_t* base, int length, int (*compare)(const void*, const void*));
 
-void network_sort11(uint16_t* base);
-void network_sort12(uint16_t* base);
-void network_sort13(uint16_t* base);
-void network_sort14(uint16_t* base);
-void network_sort15(uint16_t* base);
-void network_sort16(uint16_t* base);
-void network_sort17(uint16_t* base);
-void network_sort18(uint16_t* base);
-void network_sort19(uint16_t* base);
-void network_sort20(uint16_t* base);
-void network_sort21(uint16_t* base);
-void network_sort22(uint16_t* base);
-void network_sort23(uint16_t* base);
-void network_sort24(uint16_t* base);
+#define NETWORK_SORT_DECLARE(n) void network_sort##n(uint16_t* base);
+SORTING_NETWORKS(NETWORK_SORT_DECLARE)
 
 #endif
@@ -0,0 +1,197 @@
+#include <pthread.h>
+
+#include "network_sort_avx2.h"
+#include "sorting_networks.h"
+
+#ifdef CPU_X86_SIMD
+
+#include "point_avx2.h"
+
+#define NETWORK_MAX_LENGTH 32
+#define NETWORK_MAX_LAYERS 512
+
+// Each layer of a network is applied to all 32 lanes at once.
+// The partner of every lane is gathered from the four 128 bit halves
+// of the two registers (direct or swapped) with byte shuffles,
+// then the lanes with the higher index of each pair keep the maximum.
+// Lanes without a partner are paired with themselves.
+typedef struct {
+	uint8_t control[2][4][32];
+	uint8_t upper[2][32];
+	uint8_t sources; // bit mask of the sources any lane reads from
+} __attribute__((aligned(32))) NetworkLayer;
+
+typedef struct {
+	int layer_count;
+	NetworkLayer* layers;
+} Network;
+
+#define NETWORK_PAIR(a, b) {a, b},
+#define NETWORK_PAIRS(n) static const uint8_t network##n##_pairs[][2] = { NETWORK##n(NETWORK_PAIR) };
+SORTING_NETWORKS(NETWORK_PAIRS)
+
+static NetworkLayer network_layers[NETWORK_MAX_LAYERS];
+static Network networks[NETWORK_MAX_LENGTH + 1];
+static pthread_once_t network_once = PTHREAD_ONCE_INIT;
+
+// Groups the comparators into layers as early as their inputs allow
+// and builds the shuffle controls for each layer
+void network_sort_avx2_add(int length, const uint8_t (*pairs)[2], int count, int* layer_index) {
+	uint8_t ready[NETWORK_MAX_LENGTH] = {0}; // first layer each element is free
+	uint8_t partner[NETWORK_MAX_LAYERS][NETWORK_MAX_LENGTH];
+	int layer_count = 0;
+	
+	for (int i = 0; i < count; i++) {
+		int a = pairs[i][0];
+		int b = pairs[i][1];
+		int layer = ready[a] > ready[b] ? ready[a] : ready[b];
+		
+		if (layer == layer_count) {
+			for (int j = 0; j < NETWORK_MAX_LENGTH; j++) partner[layer][j] = j;
+			layer_count++;
+		}
+		
+		partner[layer][a] = b;
+		partner[layer][b] = a;
+		ready[a] = layer + 1;
+		ready[b] = layer + 1;
+	}
+	
+	if (*layer_index + layer_count > NETWORK_MAX_LAYERS) return;
+	
+	NetworkLayer* layers = &network_layers[*layer_index];
+	*layer_index += layer_count;
+	
+	for (int l = 0; l < layer_count; l++) {
+		layers[l].sources = 0;
+		
+		for (int lane = 0; lane < NETWORK_MAX_LENGTH; lane++) {
+			int out = lane >> 4;
+			int half = (lane >> 3) & 1;
+			int source = partner[l][lane];
+			int quarter = source >> 3;
+			
+			// Quarters available in each half of R0, swapped R0, R1 and swapped R1
+			int provides[4];
+			provides[0] = half;
+			provides[1] = 1 - half;
+			provides[2] = 2 + half;
+			provides[3] = 3 - half;
+			
+			for (int s = 0; s < 4; s++) {
+				for (int k = 0; k < 2; k++) {
+					int byte = ((lane & 15) << 1) + k;
+					layers[l].control[out][s][byte] = provides[s] == quarter ? ((source & 7) << 1) + k : 0x80;
+				}
+				
+				if (provides[s] == quarter) layers[l].sources |= 1 << s;
+			}
+			
+			uint8_t upper = source < lane ? 0xFF : 0;
+			layers[l].upper[out][((lane & 15) << 1)] = upper;
+			layers[l].upper[out][((lane & 15) << 1) + 1] = upper;
+		}
+	}
+	
+	networks[length].layers = layers;
+	networks[length].layer_count = layer_count;
+}
+
+void network_sort_avx2_init() {
+	int layer_index = 0;
+	
+#define NETWORK_ADD(n) network_sort_avx2_add(n, network##n##_pairs, sizeof(network##n##_pairs) / sizeof(network##n##_pairs[0]), &layer_index);
+	SORTING_NETWORKS(NETWORK_ADD)
+}
+
+__attribute__((target("avx2")))
+static inline __m256i network_shuffle_avx2(__m256i v, const uint8_t* control) {
+	return _mm256_shuffle_epi8(v, _mm256_load_si256((const __m256i*) control));
+}
+
+// Up to 16 points only need the first register and its swapped halves.
+// Layers that stay within each 128 bit half skip the swap entirely.
+__attribute__((target("avx2")))
+static inline void network_run_avx2(const Network* network, __m256i* v) {
+	for (int l = 0; l < network->layer_count; l++) {
+		const NetworkLayer* layer = &network->layers[l];
+		__m256i p = network_shuffle_avx2(v[0], layer->control[0][0]);
+		
+		if (layer->sources & 2) {
+			__m256i swapped = _mm256_permute2x128_si256(v[0], v[0], 1);
+			p = _mm256_or_si256(p, network_shuffle_avx2(swapped, layer->control[0][1]));
+		}
+		
+		__m256i upper = _mm256_load_si256((const __m256i*) layer->upper[0]);
+		v[0] = _mm256_blendv_epi8(_mm256_min_epu16(v[0], p), _mm256_max_epu16(v[0], p), upper);
+	}
+}
+
+// Gathers the partner of every lane in one output register from the four sources
+__attribute__((target("avx2")))
+static inline __m256i network_gather2_avx2(const NetworkLayer* layer, int out, __m256i a, __m256i a_swapped, __m256i b, __m256i b_swapped) {
+	__m256i p = network_shuffle_avx2(a, layer->control[out][0]);
+	
+	if (layer->sources & 2) p = _mm256_or_si256(p, network_shuffle_avx2(a_swapped, layer->control[out][1]));
+	if (layer->sources & 4) p = _mm256_or_si256(p, network_shuffle_avx2(b, layer->control[out][2]));
+	if (layer->sources & 8) p = _mm256_or_si256(p, network_shuffle_avx2(b_swapped, layer->control[out][3]));
+	
+	return p;
+}
+
+__attribute__((target("avx2")))
+static inline void network_run2_avx2(const Network* network, __m256i* v) {
+	__m256i a = v[0];
+	__m256i b = v[1];
+	
+	for (int l = 0; l < network->layer_count; l++) {
+		const NetworkLayer* layer = &network->layers[l];
+		__m256i a_swapped = _mm256_permute2x128_si256(a, a, 1);
+		__m256i b_swapped = _mm256_permute2x128_si256(b, b, 1);
+		
+		__m256i pa = network_gather2_avx2(layer, 0, a, a_swapped, b, b_swapped);
+		__m256i pb = network_gather2_avx2(layer, 1, a, a_swapped, b, b_swapped);
+		
+		__m256i upper_a = _mm256_load_si256((const __m256i*) layer->upper[0]);
+		__m256i upper_b = _mm256_load_si256((const __m256i*) layer->upper[1]);
+		
+		a = _mm256_blendv_epi8(_mm256_min_epu16(a, pa), _mm256_max_epu16(a, pa), upper_a);
+		b = _mm256_blendv_epi8(_mm256_min_epu16(b, pb), _mm256_max_epu16(b, pb), upper_b);
+	}
+	
+	v[0] = a;
+	v[1] = b;
+}
+
+// Sorts up to 32 points held in two registers.
+// Returns 0 if there is no network for this length.
+__attribute__((target("avx2")))
+int network_sort_avx2_registers(__m256i* v, int length) {
+	if (length > NETWORK_MAX_LENGTH) return 0;
+	
+	pthread_once(&network_once, network_sort_avx2_init);
+	
+	const Network* network = &networks[length];
+	if (network->layer_count == 0) return 0;
+	
+	if (length > 16) network_run2_avx2(network, v);
+	else network_run_avx2(network, v);
+	
+	return 1;
+}
+
+// Sorts the points in registers with the same networks as the scalar sort.
+// Returns 0 if there is no network for this length.
+__attribute__((target("avx2")))
+int network_sort_avx2(uint16_t* base, int length) {
+	__m256i v[2];
+	point_load_exact_avx2(base, length, v);
+	
+	if (!network_sort_avx2_registers(v, length)) return 0;
+	
+	point_store_exact_avx2(base, length, v);
+	
+	return 1;
+}
+
+#endif
@@ -0,0 +1,22 @@
+#include <stdint.h>
+
+#include "cpu.h"
+
+#ifndef NETWORK_SORT_AVX2_H
+#define NETWORK_SORT_AVX2_H
+
+// Sorting in memory only uses AVX2 from 26 points up. Measured with tools/network_bench,
+// the scalar networks are faster from 17 to 23 points (65 vs 72 ns at 22),
+// about even at 24 and 25, and slower from 26 (87 vs 83 ns at 26, 102 vs 80 ns at 30).
+// network_sort_avx2 reads and writes exactly length points, so any buffer works.
+#define NETWORK_SORT_AVX2_MIN_LENGTH 26
+#define NETWORK_SORT_AVX2_MIN_REGISTER_LENGTH 8
+
+#ifdef CPU_X86_SIMD
+#include <immintrin.h>
+
+int network_sort_avx2_registers(__m256i* v, int length);
+int network_sort_avx2(uint16_t* base, int length);
+#endif
+
+#endif
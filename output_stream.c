@@ -3,6 +3,8 @@
 #include "output_stream.h"
 
 #define CHUNK 16384
+#define LEVEL 2
+#define BLOCKS_PER_THREAD 2 // Blocks in flight for each compression thread
 
 // Inner loop of the write method
 // This is where the zlib work is actually happening
@@ -45,10 +47,10 @@ void output_stream_write_compressed(OutputStream* s, char* buffer, size_t size)
 	
 	if (copy_amount < available) return;
 	
-	size_t to_copy = size - buffer_pos;
 	do {
 		output_stream_write_inner(s, Z_NO_FLUSH);
 		
+		size_t to_copy = size - buffer_pos;
 		available = CHUNK - s->in_count;
 		copy_amount = available < to_copy ? available : to_copy;
 		memcpy(&s->in_buffer[s->in_count], &buffer[buffer_pos], copy_amount);
@@ -60,7 +62,195 @@ void output_stream_write_compressed(OutputStream* s, char* buffer, size_t size)
 	
 }
 
-OutputStream* output_stream_create(char* filename, int compressed) {
+// Compresses blocks in the order they were submitted until the stream is destroyed.
+// Each block is raw deflate data ending on a byte boundary, so the blocks can be
+// concatenated into one stream, and the CRCs are combined when the blocks are written.
+void* output_stream_compress_function(void* arg) {
+	OutputStream* s = (OutputStream*) arg;
+	z_stream strm;
+	
+	strm.zalloc = Z_NULL;
+	strm.zfree = Z_NULL;
+	strm.opaque = Z_NULL;
+	deflateInit2(&strm, LEVEL, Z_DEFLATED, -15, 9, Z_DEFAULT_STRATEGY);
+	
+	while (1) {
+		pthread_mutex_lock(&s->lock);
+		
+		while (s->taken == s->submitted && !s->stop) {
+			pthread_cond_wait(&s->block_submitted, &s->lock);
+		}
+		
+		if (s->taken == s->submitted) {
+			pthread_mutex_unlock(&s->lock);
+			break;
+		}
+		
+		OutputBlock* block = &s->blocks[s->taken % s->n_blocks];
+		s->taken++;
+		
+		pthread_mutex_unlock(&s->lock);
+		
+		block->crc = crc32(0, block->in_buffer, block->in_count);
+		
+		deflateReset(&strm);
+		strm.next_in = block->in_buffer;
+		strm.avail_in = block->in_count;
+		strm.next_out = block->out_buffer;
+		strm.avail_out = compressBound(s->block_size) + CHUNK;
+		
+		int result = deflate(&strm, block->last ? Z_FINISH : Z_SYNC_FLUSH);
+		
+		if (result == Z_STREAM_ERROR || strm.avail_in > 0) {
+			printf("zlib STREAM_ERROR\n");
+		}
+		
+		block->out_count = strm.next_out - block->out_buffer;
+		
+		pthread_mutex_lock(&s->lock);
+		block->done = 1;
+		pthread_cond_broadcast(&s->block_done);
+		pthread_mutex_unlock(&s->lock);
+	}
+	
+	(void)deflateEnd(&strm);
+	
+	pthread_exit(NULL);
+}
+
+// Writes a little endian 32 bit value for the gzip header and trailer
+void output_stream_write_le32(OutputStream* s, uint32_t value) {
+	uint8_t bytes[4];
+	
+	for (int i = 0; i < 4; i++) {
+		bytes[i] = (value >> (8 * i)) & 0xFF;
+	}
+	
+	fwrite(bytes, 1, 4, s->file);
+}
+
+// Waits for the oldest submitted block to be compressed, then writes it and frees it
+void output_stream_write_block(OutputStream* s) {
+	OutputBlock* block = &s->blocks[s->written % s->n_blocks];
+	
+	pthread_mutex_lock(&s->lock);
+	
+	while (!block->done) {
+		pthread_cond_wait(&s->block_done, &s->lock);
+	}
+	
+	pthread_mutex_unlock(&s->lock);
+	
+	// The gzip header goes after any raw data written before the first block,
+	// so it is written with the first block
+	if (!s->header_written) {
+		uint8_t header[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 3};
+		fwrite(header, 1, 10, s->file);
+		s->header_written = 1;
+	}
+	
+	fwrite(block->out_buffer, 1, block->out_count, s->file);
+	
+	s->crc = crc32_combine(s->crc, block->crc, block->in_count);
+	s->total_in += block->in_count;
+	
+	block->in_count = 0;
+	block->done = 0;
+	s->written++;
+}
+
+// Hands the block being filled to the compression threads
+void output_stream_submit_block(OutputStream* s, int last) {
+	s->blocks[s->submitted % s->n_blocks].last = last;
+	
+	pthread_mutex_lock(&s->lock);
+	s->submitted++;
+	pthread_cond_signal(&s->block_submitted);
+	pthread_mutex_unlock(&s->lock);
+}
+
+// Copies data into blocks, submitting each one as it fills.
+// Once every block is in use, the oldest one is written to make room.
+void output_stream_write_parallel(OutputStream* s, char* buffer, size_t size) {
+	while (size > 0) {
+		if (s->submitted - s->written == (uint64_t)s->n_blocks) output_stream_write_block(s);
+		
+		OutputBlock* block = &s->blocks[s->submitted % s->n_blocks];
+		size_t available = s->block_size - block->in_count;
+		size_t copy_amount = available < size ? available : size;
+		
+		memcpy(&block->in_buffer[block->in_count], buffer, copy_amount);
+		block->in_count += copy_amount;
+		buffer += copy_amount;
+		size -= copy_amount;
+		
+		if (block->in_count == s->block_size) output_stream_submit_block(s, 0);
+	}
+}
+
+// Compresses the partial block as the last one, writes every block and the gzip trailer
+void output_stream_finish_parallel(OutputStream* s) {
+	if (s->finished) return;
+	
+	if (s->submitted - s->written == (uint64_t)s->n_blocks) output_stream_write_block(s);
+	output_stream_submit_block(s, 1);
+	
+	while (s->written < s->submitted) output_stream_write_block(s);
+	
+	output_stream_write_le32(s, s->crc);
+	output_stream_write_le32(s, s->total_in & 0xFFFFFFFF);
+	
+	s->finished = 1;
+}
+
+void output_stream_start_threads(OutputStream* s, int n_threads, size_t block_size) {
+	s->n_threads = n_threads;
+	s->block_size = block_size;
+	s->n_blocks = n_threads * BLOCKS_PER_THREAD;
+	s->blocks = calloc(s->n_blocks, sizeof(OutputBlock));
+	s->crc = crc32(0, Z_NULL, 0);
+	
+	for (int i = 0; i < s->n_blocks; i++) {
+		s->blocks[i].in_buffer = calloc(block_size, sizeof(unsigned char));
+		s->blocks[i].out_buffer = calloc(compressBound(block_size) + CHUNK, sizeof(unsigned char));
+	}
+	
+	pthread_mutex_init(&s->lock, NULL);
+	pthread_cond_init(&s->block_submitted, NULL);
+	pthread_cond_init(&s->block_done, NULL);
+	
+	s->threads = calloc(n_threads, sizeof(pthread_t));
+	
+	for (int i = 0; i < n_threads; i++) {
+		pthread_create(&s->threads[i], NULL, output_stream_compress_function, s);
+	}
+}
+
+void output_stream_stop_threads(OutputStream* s) {
+	pthread_mutex_lock(&s->lock);
+	s->stop = 1;
+	pthread_cond_broadcast(&s->block_submitted);
+	pthread_mutex_unlock(&s->lock);
+	
+	for (int i = 0; i < s->n_threads; i++) {
+		pthread_join(s->threads[i], NULL);
+	}
+	
+	for (int i = 0; i < s->n_blocks; i++) {
+		free(s->blocks[i].in_buffer);
+		free(s->blocks[i].out_buffer);
+	}
+	
+	free(s->blocks);
+	free(s->threads);
+	
+	pthread_mutex_destroy(&s->lock);
+	pthread_cond_destroy(&s->block_submitted);
+	pthread_cond_destroy(&s->block_done);
+}
+
+// With compression and more than one thread, blocks of block_size bytes are compressed in parallel
+OutputStream* output_stream_create(char* filename, int compressed, int n_threads, size_t block_size) {
 	FILE* file = fopen(filename, "wb");
 	if (file == NULL) {
 		printf("Failed to open file `%s` for writing\n", filename);
@@ -72,11 +262,13 @@ OutputStream* output_stream_create(char* filename, int compressed) {
 	retval->file = file;
 	retval->compressed = compressed;
 	
-	if (compressed) {
+	if (compressed && n_threads > 1) {
+		output_stream_start_threads(retval, n_threads, block_size);
+	} else if (compressed) {
 		retval->strm.zalloc = Z_NULL;
 		retval->strm.zfree = Z_NULL;
 		retval->strm.opaque = Z_NULL;
-		int result = deflateInit2(&retval->strm, 2, Z_DEFLATED,
+		int result = deflateInit2(&retval->strm, LEVEL, Z_DEFLATED,
 					15 | 16, 9, Z_DEFAULT_STRATEGY);
 		if (result != Z_OK) {
 			printf("zlib init failure\n");
@@ -98,7 +290,9 @@ OutputStream* output_stream_create(char* filename, int compressed) {
 }
 
 void output_stream_destroy(OutputStream* s) {
-	if (s->compressed) {
+	if (s->n_threads > 0) {
+		output_stream_stop_threads(s);
+	} else if (s->compressed) {
 		(void)deflateEnd(&s->strm);
 		free(s->in_buffer);
 		free(s->out_buffer);
@@ -110,7 +304,8 @@ void output_stream_destroy(OutputStream* s) {
 }
 
 void output_stream_flush(OutputStream* s) {
-	if (s->compressed) output_stream_write_inner(s, Z_FINISH);
+	if (s->n_threads > 0) output_stream_finish_parallel(s);
+	else if (s->compressed) output_stream_write_inner(s, Z_FINISH);
 }
 
 void output_stream_seek(OutputStream* s, long offset) {
@@ -124,6 +319,8 @@ void output_stream_write_raw(OutputStream* s, void* buffer, size_t size) {
 void output_stream_write(OutputStream* s, void* buffer, size_t size) {
 	if (!s->compressed) {
 		output_stream_write_raw(s, buffer, size);
+	} else if (s->n_threads > 0) {
+		output_stream_write_parallel(s, buffer, size);
 	} else {
 		output_stream_write_compressed(s, buffer, size);
 	}
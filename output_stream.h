@@ -1,10 +1,23 @@
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
+#include <pthread.h>
 #include <zlib.h>
 
 #ifndef OUTPUT_STREAM_H
 #define OUTPUT_STREAM_H
 
+// A block of input compressed on its own by one of the compression threads
+typedef struct {
+	unsigned char* in_buffer;
+	size_t in_count;
+	unsigned char* out_buffer;
+	size_t out_count;
+	uLong crc; // CRC of the input
+	int last; // Ends the deflate stream
+	int done; // Compressed and ready to write
+} OutputBlock;
+
 typedef struct {
 	FILE* file;
 	int compressed;
@@ -12,9 +25,29 @@ typedef struct {
 	unsigned char* in_buffer;
 	unsigned char* out_buffer;
 	size_t in_count;
+	
+	// Block parallel compression, used with more than one compression thread.
+	// Blocks are compressed independently and written in order as a single gzip member,
+	// by the thread that writes to the stream.
+	int n_threads;
+	pthread_t* threads;
+	size_t block_size;
+	OutputBlock* blocks;
+	int n_blocks;
+	uint64_t submitted; // Blocks handed to the compression threads
+	uint64_t taken; // Blocks taken by a compression thread
+	uint64_t written; // Blocks written to the file
+	uLong crc; // CRC of the written input
+	uint64_t total_in; // Size of the written input
+	int header_written;
+	int finished;
+	int stop;
+	pthread_mutex_t lock;
+	pthread_cond_t block_submitted;
+	pthread_cond_t block_done;
 } OutputStream;
 
-OutputStream* output_stream_create(char* filename, int compressed);
+OutputStream* output_stream_create(char* filename, int compressed, int n_threads, size_t block_size);
 void output_stream_destroy(OutputStream* stream);
 
 void output_stream_flush(OutputStream* stream);
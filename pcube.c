@@ -49,10 +49,19 @@ void pcube_write_count(OutputStream* stream, uint64_t count) {
 	output_stream_write_raw(stream, bytes, COUNT_WIDTH);
 }
 
-void pcube_write_key(OutputStream* stream, Key key) {
-	Point dim_pt = key_get_dimensions(key);
+// Upper bound on the encoded size of a key. The dimensions of a polycube
+// add up to at most n+2, so its volume is at most that of a cube with a third of that side.
+size_t pcube_max_key_size(uint8_t length) {
+	size_t side = (length + 4) / 3;
+	size_t bits = side * side * side;
 	
-	uint8_t dim[3];
+	return 3 + (bits >> 3) + ((bits % 8) > 0);
+}
+
+// Encodes a key as its dimensions followed by one bit for each place of its bounding box.
+// Returns the number of bytes written.
+size_t pcube_encode_key(Key key, Point dim_pt, uint8_t* buffer) {
+	uint8_t* dim = buffer;
 	dim[0] = POINT_GET_X(dim_pt);
 	dim[1] = POINT_GET_Y(dim_pt);
 	dim[2] = POINT_GET_Z(dim_pt);
@@ -62,12 +71,10 @@ void pcube_write_key(OutputStream* stream, Key key) {
 	offsets[1] = dim[2];
 	offsets[2] = 1;
 	
-	output_stream_write(stream, dim, 3);
-	
-	uint8_t bits = dim[0] * dim[1] * dim[2];
-	uint8_t bytes = bits >> 3;
+	uint16_t bits = dim[0] * dim[1] * dim[2];
+	uint16_t bytes = bits >> 3;
 	bytes += bits > (bytes << 3);
-	uint8_t data[bytes];
+	uint8_t* data = &buffer[3];
 	memset(data, 0, bytes);
 	
 	// Accounts for the base (1,1,1) base point
@@ -76,18 +83,38 @@ void pcube_write_key(OutputStream* stream, Key key) {
 	for (int i = 0; i < key.length; i++) {
 		Point pt = key.data[i];
 		uint16_t position = offsets[0] * POINT_GET_X(pt) + offsets[1] * POINT_GET_Y(pt) + POINT_GET_Z(pt) - base_offset;
-		uint8_t byte = position >> 3;
+		uint16_t byte = position >> 3;
 		uint8_t bit = position - (byte << 3);
 		
 		data[byte] |= 1 << bit;
 	}
 	
-	output_stream_write(stream, data, bytes);
+	return 3 + bytes;
+}
+
+// Encodes the first count keys of a list back to back, using their stored dimensions.
+// Returns the number of bytes written, at most count times pcube_max_key_size.
+size_t pcube_encode_keys(const KeyList* keys, uint64_t count, uint8_t* buffer) {
+	size_t size = 0;
+	
+	for (uint64_t i = 0; i < count; i++) {
+		size += pcube_encode_key(key_list_get(keys, i), key_list_get_dimensions(keys, i), &buffer[size]);
+	}
+	
+	return size;
+}
+
+void pcube_write_key(OutputStream* stream, Key key) {
+	uint8_t buffer[pcube_max_key_size(key.length)];
+	
+	size_t size = pcube_encode_key(key, key_get_dimensions(&key), buffer);
+	
+	output_stream_write(stream, buffer, size);
 }
 
-void pcube_write_keys(OutputStream* stream, Key* keys, uint64_t count) {
+void pcube_write_keys(OutputStream* stream, KeyList* keys, uint64_t count) {
 	for (uint64_t i = 0; i < count; i++) {
-		pcube_write_key(stream, keys[i]);
+		pcube_write_key(stream, key_list_get(keys, i));
 	}
 }
 
@@ -194,12 +221,16 @@ int pcube_read_key(InputStream* stream, Key* key_output) {
 	return 1;
 }
 
-uint64_t pcube_read_keys(InputStream* stream, Key* output_keys, uint64_t count) {
+uint64_t pcube_read_keys(InputStream* stream, KeyList* output_keys, uint64_t count) {
 	uint64_t i = 0;
 	for (i = 0; i < count; i++) {
-		int result = pcube_read_key(stream, &output_keys[i]);
+		Key key;
+		int result = pcube_read_key(stream, &key);
 		
 		if (!result) break;
+		
+		key.source_index = 0;
+		key_list_set(output_keys, i, &key);
 	}
 	
 	return i;
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "key.h"
+#include "key_list.h"
 #include "input_stream.h"
 #include "output_stream.h"
 
@@ -9,13 +10,16 @@
 
 void pcube_write_header(OutputStream* stream, uint8_t compressed);
 void pcube_write_count(OutputStream* stream, uint64_t count);
+size_t pcube_max_key_size(uint8_t length);
+size_t pcube_encode_key(Key key, Point dimensions, uint8_t* buffer);
+size_t pcube_encode_keys(const KeyList* keys, uint64_t count, uint8_t* buffer);
 void pcube_write_key(OutputStream* stream, Key key);
-void pcube_write_keys(OutputStream* streame, Key* keys, uint64_t count);
+void pcube_write_keys(OutputStream* streame, KeyList* keys, uint64_t count);
 
 int pcube_read_header(InputStream* stream);
 uint64_t pcube_read_count(InputStream* stream);
 uint8_t pcube_read_n(InputStream* stream);
 int pcube_read_key(InputStream* stream, Key* key);
-uint64_t pcube_read_keys(InputStream* stream, Key* output_keys, uint64_t count);
+uint64_t pcube_read_keys(InputStream* stream, KeyList* output_keys, uint64_t count);
 
 #endif
@@ -66,6 +66,18 @@ Point point_rotate(PointData point_data, uint8_t rot_num) {
 	return POINT_SET_X(p[r[0]]) + POINT_SET_Y(p[r[1]]) + POINT_SET_Z(p[r[2]]);
 }
 
+// Rotating dimensions only swaps the axes, since reflections keep the sizes
+Point point_rotate_dimensions(Point dimensions, uint8_t rot_num) {
+	uint8_t d[3];
+	d[0] = POINT_GET_X(dimensions);
+	d[1] = POINT_GET_Y(dimensions);
+	d[2] = POINT_GET_Z(dimensions);
+	
+	const uint8_t* r = point_rotations_lut[rot_num];
+	
+	return POINT_SET_X(d[r[0] % 3]) + POINT_SET_Y(d[r[1] % 3]) + POINT_SET_Z(d[r[2] % 3]);
+}
+
 const uint8_t* point_get_rotation_data(uint8_t rot_num) {
 	return point_rotations_lut[rot_num];
 }
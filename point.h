@@ -33,6 +33,8 @@ Point point_get_offset(Point point, int face);
 
 Point point_rotate(PointData point_data, uint8_t rot_num);
 
+Point point_rotate_dimensions(Point dimensions, uint8_t rot_num);
+
 const uint8_t* point_get_rotation_data(uint8_t rot_num);
 
 int point_compare(const void* a, const void* b);
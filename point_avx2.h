@@ -0,0 +1,94 @@
+#include <stddef.h>
+
+#include "cpu.h"
+#include "point.h"
+
+#ifndef POINT_AVX2_H
+#define POINT_AVX2_H
+
+#ifdef CPU_X86_SIMD
+
+#include <immintrin.h>
+
+// Builds a 32 bit lane mask for the given number of points (rounded up to pairs)
+__attribute__((target("avx2")))
+static inline __m256i point_mask_avx2(size_t count) {
+	__m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	return _mm256_cmpgt_epi32(_mm256_set1_epi32((count + 1) >> 1), lanes);
+}
+
+// Loads up to 32 points into two registers without reading past a Key.
+// Masked loads work on pairs of points, so odd lengths pick up one
+// extra point that is never used.
+__attribute__((target("avx2")))
+static inline void point_load_avx2(const Point* points, size_t length, __m256i* v) {
+	if (length > 16) {
+		v[0] = _mm256_loadu_si256((const __m256i*) points);
+		v[1] = _mm256_maskload_epi32((const int*) &points[16], point_mask_avx2(length - 16));
+	} else {
+		v[0] = _mm256_maskload_epi32((const int*) points, point_mask_avx2(length));
+		v[1] = _mm256_setzero_si256();
+	}
+}
+
+// Stores up to 32 points from two registers without writing past a Key.
+// As with loading, odd lengths write one extra point.
+__attribute__((target("avx2")))
+static inline void point_store_avx2(Point* points, size_t length, __m256i* v) {
+	if (length > 16) {
+		_mm256_storeu_si256((__m256i*) points, v[0]);
+		_mm256_maskstore_epi32((int*) &points[16], point_mask_avx2(length - 16), v[1]);
+	} else {
+		_mm256_maskstore_epi32((int*) points, point_mask_avx2(length), v[0]);
+	}
+}
+
+// Loads exactly length points (up to 32), for buffers that are not padded like a Key.
+// Whole pairs use a masked load, and the last point of an odd length is blended
+// into its lane, leaving the rest of the registers zero.
+__attribute__((target("avx2")))
+static inline void point_load_exact_avx2(const Point* points, size_t length, __m256i* v) {
+	size_t even = length & ~(size_t)1;
+	
+	if (length > 16) {
+		v[0] = _mm256_loadu_si256((const __m256i*) points);
+		v[1] = _mm256_maskload_epi32((const int*) &points[16], point_mask_avx2(even - 16));
+	} else {
+		v[0] = _mm256_maskload_epi32((const int*) points, point_mask_avx2(even));
+		v[1] = _mm256_setzero_si256();
+	}
+	
+	if (length & 1) {
+		size_t last = length - 1;
+		__m256i lanes = _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+		__m256i select = _mm256_cmpeq_epi16(lanes, _mm256_set1_epi16(last & 15));
+		
+		v[last >> 4] = _mm256_blendv_epi8(v[last >> 4], _mm256_set1_epi16(points[last]), select);
+	}
+}
+
+// Stores exactly length points (up to 32) from two registers.
+// Whole pairs use a masked store, and the last point of an odd length is stored on its own.
+__attribute__((target("avx2")))
+static inline void point_store_exact_avx2(Point* points, size_t length, __m256i* v) {
+	size_t even = length & ~(size_t)1;
+	
+	if (length > 16) {
+		_mm256_storeu_si256((__m256i*) points, v[0]);
+		_mm256_maskstore_epi32((int*) &points[16], point_mask_avx2(even - 16), v[1]);
+	} else {
+		_mm256_maskstore_epi32((int*) points, point_mask_avx2(even), v[0]);
+	}
+	
+	if (length & 1) {
+		size_t last = length - 1;
+		Point lanes[16];
+		
+		_mm256_storeu_si256((__m256i*) lanes, v[last >> 4]);
+		points[last] = lanes[last & 15];
+	}
+}
+
+#endif
+
+#endif
@@ -9,8 +9,29 @@
 #include "reader.h"
 #include "writer.h"
 
-#define SINGLE_THREAD_LENGTH 9
 #define N_THREADS 16
+#define COMPRESS_BLOCK_KB 256 // Default block size for parallel compression
+
+// The work is split between the threads at the first length with at least
+// this many seeds per thread, using the known counts of each length
+#define SPLIT_SEEDS_PER_THREAD 1000
+#define SPLIT_MIN_LENGTH 7
+#define SPLIT_MAX_LENGTH 11
+#define SPLIT_INITIAL_CAPACITY 100000
+
+const uint64_t known_counts[SPLIT_MAX_LENGTH + 1] = {0, 1, 1, 2, 8, 29, 166, 1023, 6922, 48311, 346543, 2522522};
+
+// Picks the length the seeds are expanded to before the threads split them.
+// More threads need more seeds to balance, but the seeds are held in memory.
+int get_split_length(int n_threads) {
+	int length = SPLIT_MIN_LENGTH;
+	
+	while (length < SPLIT_MAX_LENGTH && known_counts[length] < (uint64_t) SPLIT_SEEDS_PER_THREAD * n_threads) {
+		length++;
+	}
+	
+	return length;
+}
 
 typedef struct {
 	FILE* results_file;
@@ -79,11 +100,17 @@ Reader* build_reader(char* opt, char* filename) {
 		}
 	}
 	
+	if (len > 5) {
+		if(strcmp(&filename[len-5], ".rank") == 0) {
+			mode = ReadRank;
+		}
+	}
+	
 	return reader_create(filename, mode);
 	
 }
 
-Writer* build_writer(char* opt, char* filename, uint8_t new_length) {
+Writer* build_writer(char* opt, char* filename, uint8_t new_length, int compress_threads, int block_kb) {
 	int len = strlen(filename);
 	
 	WriterMode mode = WriteBitFace;
@@ -96,13 +123,19 @@ Writer* build_writer(char* opt, char* filename, uint8_t new_length) {
 		}
 	}
 	
-	return writer_create(filename, mode, new_length, compressed);
+	if (len > 5) {
+		if(strcmp(&filename[len-5], ".rank") == 0) {
+			mode = WriteRank;
+		}
+	}
+	
+	return writer_create(filename, mode, new_length, compressed, compress_threads, (size_t)block_kb * 1024);
 }
 
 void convert_files(Reader* reader, Writer* writer) {
 	printf("Converting data of equal length between formats...\n");
 	
-	Key* keys = calloc(READER_MAX_COUNT, sizeof(Key));
+	KeyList* keys = key_list_create(reader_get_n(reader), READER_MAX_COUNT);
 	
 	uint64_t total = 0;
 	
@@ -116,6 +149,7 @@ void convert_files(Reader* reader, Writer* writer) {
 	
 	writer_write_count(writer, total);
 	writer_destroy(writer);
+	key_list_destroy(keys);
 	
 	printf("Processed %lld polycubes.\n", (long long int) total);
 }
@@ -130,9 +164,20 @@ int main (int argc, char** argv) {
 	
 	int new_length;
 	Writer* writer = NULL;
+	char* writer_opt = NULL;
+	char* writer_file = NULL;
 	Reader* reader = NULL;
 	int n_threads = N_THREADS;
+	int compress_threads = -1; // Same as the compute threads unless given
+	int block_kb = COMPRESS_BLOCK_KB;
 	int output_all = 0;
+	int print_stats = 0;
+	GeneratorStats stats = {0};
+	uint64_t steals = 0;
+	uint64_t steal_misses = 0;
+	uint64_t level_steals = 0;
+	uint64_t idle_waits = 0;
+	uint64_t writer_waits = 0;
 	
 	Results* results = NULL;
 	sscanf(argv[1], "%d", &new_length);
@@ -152,7 +197,7 @@ int main (int argc, char** argv) {
 			if (value == NULL) return 0;
 			int result = sscanf(value, "%d", &n_threads);
 			
-			if (result == 0) {
+			if (result == 0 || n_threads < 1) {
 				printf("Invalid number of threads\n");
 				return 0;
 			}
@@ -165,16 +210,35 @@ int main (int argc, char** argv) {
 			reader = build_reader(opt, value);
 			if (reader == NULL) return 0;
 		} else if (strncmp(argv[i], "-o", 2) == 0) {
-			char* opt = argv[i];
+			// The writer is built after all flags are read, since it depends on the thread counts
+			writer_opt = argv[i];
+			writer_file = get_value(&i, argc, argv);
+			
+			if (writer_file == NULL) return 0;
+		} else if (strcmp(argv[i], "-zt") == 0) {
 			char* value = get_value(&i, argc, argv);
 			
 			if (value == NULL) return 0;
+			int result = sscanf(value, "%d", &compress_threads);
 			
-			writer = build_writer(opt, value, new_length);
+			if (result == 0 || compress_threads < 1) {
+				printf("Invalid number of compression threads\n");
+				return 0;
+			}
+		} else if (strcmp(argv[i], "-zb") == 0) {
+			char* value = get_value(&i, argc, argv);
+			
+			if (value == NULL) return 0;
+			int result = sscanf(value, "%d", &block_kb);
 			
-			if (writer == NULL) return 0;
+			if (result == 0 || block_kb < 1) {
+				printf("Invalid compression block size\n");
+				return 0;
+			}
 		} else if (strcmp(argv[i], "-a") == 0) {
 			output_all = 1;
+		} else if (strcmp(argv[i], "-s") == 0) {
+			print_stats = 1;
 		} else if (strcmp(argv[i], "-r") == 0) {
 			char* value = get_value(&i, argc, argv);
 			
@@ -189,6 +253,14 @@ int main (int argc, char** argv) {
 		}
 	}
 	
+	if (writer_file != NULL) {
+		if (compress_threads < 0) compress_threads = n_threads;
+		
+		writer = build_writer(writer_opt, writer_file, new_length, compress_threads, block_kb);
+		
+		if (writer == NULL) return 0;
+	}
+	
 	char input_length = 0;
 	if (reader != NULL) {
 		input_length = reader_get_n(reader);
@@ -214,17 +286,22 @@ int main (int argc, char** argv) {
 		}
 	}
 	
-	Key* output_keys = calloc(100000, sizeof(Key));
+	KeyList* output_keys = NULL;
 	uint64_t n_generated = 0;
 	
-	if (input_length < SINGLE_THREAD_LENGTH) {
-		int target_length = new_length < SINGLE_THREAD_LENGTH ? new_length : SINGLE_THREAD_LENGTH;
+	int split_length = get_split_length(n_threads);
+	
+	// Expand the seeds up to the split length, on all threads.
+	// Idle threads steal from the busy ones, so a single start key is still shared.
+	if (input_length < split_length) {
+		int target_length = new_length < split_length ? new_length : split_length;
 		
 		int start_length = reader != NULL ? input_length : 2;
 		
-		ThreadPool* pool = thread_pool_create(1, start_length, target_length);
+		ThreadPool* pool = thread_pool_create(n_threads, start_length, target_length);
 		
 		Key start;
+		KeyList* start_keys = NULL;
 		if (reader == NULL) {
 			Point p = point_from_coords(1,1,1);
 			
@@ -235,14 +312,20 @@ int main (int argc, char** argv) {
 			start.length = 2;
 			start.source_index = 0;
 			
-			thread_pool_set_input_keys(pool, &start, 1);
+			start_keys = key_list_create(2, 1);
+			key_list_push(start_keys, &start);
+			
+			thread_pool_set_input_keys(pool, start_keys);
 		} else {
 			thread_pool_set_input_reader(pool, reader);
 		}
 		
-		thread_pool_set_output_keys(pool, output_keys);
-		
-		if (new_length <= SINGLE_THREAD_LENGTH && writer != NULL) {
+		// The keys are only kept when the second phase expands them further,
+		// otherwise they are written or just counted
+		if (new_length > split_length) {
+			output_keys = key_list_create(target_length, SPLIT_INITIAL_CAPACITY);
+			thread_pool_set_output_keys(pool, output_keys);
+		} else if (writer != NULL) {
 			thread_pool_set_output_writer(pool, writer);
 		}
 		
@@ -259,20 +342,26 @@ int main (int argc, char** argv) {
 			}
 		}
 		
+		generator_stats_add(&stats, &pool->stats);
+		steals += pool->steals;
+		steal_misses += pool->steal_misses;
+		level_steals += pool->level_steals;
+		idle_waits += pool->idle_waits;
 		thread_pool_destroy(pool);
+		key_list_destroy(start_keys);
 	}
 	
-	if (new_length > SINGLE_THREAD_LENGTH) {
-		int use_file = reader != NULL && input_length >= SINGLE_THREAD_LENGTH;
+	if (new_length > split_length) {
+		int use_file = reader != NULL && input_length >= split_length;
 		
-		int start_length = use_file ? input_length : SINGLE_THREAD_LENGTH;
+		int start_length = use_file ? input_length : split_length;
 			
 		ThreadPool* pool = thread_pool_create(n_threads, start_length, new_length);
 		
 		if (use_file) {
 			thread_pool_set_input_reader(pool, reader);
 		} else {
-			thread_pool_set_input_keys(pool, output_keys, n_generated);
+			thread_pool_set_input_keys(pool, output_keys);
 			thread_pool_enable_updates(pool);
 		}
 		
@@ -293,11 +382,24 @@ int main (int argc, char** argv) {
 			}
 		}
 		
+		generator_stats_add(&stats, &pool->stats);
+		steals += pool->steals;
+		steal_misses += pool->steal_misses;
+		level_steals += pool->level_steals;
+		idle_waits += pool->idle_waits;
+		writer_waits += pool->writer_waits;
 		thread_pool_destroy(pool);
 	}
 	
 	if (!output_all) printf("%lld polycubes found of length %d                      \n", (long long int)n_generated, new_length);
 	
+	if (print_stats) {
+		generator_stats_print(&stats);
+		printf("%lld seed ranges stolen, %lld empty ranges found while stealing\n", (long long int)steals, (long long int)steal_misses);
+		printf("%lld seed levels stolen from busy workers, %lld idle waits\n", (long long int)level_steals, (long long int)idle_waits);
+		if (writer != NULL) printf("%lld output buffers waited for the writer\n", (long long int)writer_waits);
+	}
+	
 	double diff = difftime(time(NULL), start_time);
 	
 	printf("%.f seconds elapsed\n", diff);
@@ -305,7 +407,7 @@ int main (int argc, char** argv) {
 	results_write(results);
 	results_destroy(results);
 	
-	free(output_keys);
+	key_list_destroy(output_keys);
 	
 	if (writer != NULL) {
 		writer_write_count(writer, n_generated);
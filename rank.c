@@ -0,0 +1,221 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "rank.h"
+#include "bitface.h"
+
+// Rank format:
+// A bitface string has exactly n-1 set bits among 6+5(n-2) positions, and the point
+// each slot of 5 bits belongs to must have been found by the bits before it.
+// Most bit strings break these rules, so each polycube is stored as its rank among
+// the valid strings of its length instead, which takes about a third less space.
+//
+// Ranks are computed from the number of valid completions of every prefix:
+// counts[p][c] is the number of ways to fill the bits from p on, with c bits set before p.
+
+#define RANK_COUNT(table, bit, set) ((table)->counts[(bit) * (table)->length + (set)])
+#define RANK_COUNT64(table, bit, set) ((table)->counts64[(bit) * (table)->length + (set)])
+
+// Returns the number of set bits needed before a bit for the string to stay valid.
+// Slot j (j >= 1) starts at bit 6+5(j-1) and is read from point j, found by the j-th set bit.
+int rank_required_bits(int bit) {
+	if (bit < 6) return 0;
+	if ((bit - 6) % 5 != 0) return 0;
+	
+	return 1 + (bit - 6) / 5;
+}
+
+// Returns NULL for lengths outside RANK_MIN_LENGTH..RANK_MAX_LENGTH
+RankTable* rank_table_create(uint8_t length) {
+	if (length < RANK_MIN_LENGTH || length > RANK_MAX_LENGTH) {
+		printf("Rank format not supported for length %d\n", length);
+		return NULL;
+	}
+	
+	RankTable* retval = calloc(1, sizeof(RankTable));
+	
+	retval->length = length;
+	retval->bits = 6 + 5 * (length - 2);
+	retval->counts = calloc((retval->bits + 1) * length, sizeof(RankValue));
+	
+	int set_bits = length - 1;
+	
+	RANK_COUNT(retval, retval->bits, set_bits) = 1;
+	
+	for (int bit = retval->bits - 1; bit >= 0; bit--) {
+		int required = rank_required_bits(bit);
+		
+		for (int c = required; c <= set_bits; c++) {
+			RankValue count = RANK_COUNT(retval, bit + 1, c);
+			if (c < set_bits) count += RANK_COUNT(retval, bit + 1, c + 1);
+			
+			RANK_COUNT(retval, bit, c) = count;
+		}
+	}
+	
+	// Ranks go from 0 to the number of valid strings minus one
+	RankValue max_rank = RANK_COUNT(retval, 0, 0) - 1;
+	retval->key_size = 1;
+	
+	while (max_rank >>= 8) retval->key_size++;
+	
+	// 64 bit arithmetic is much faster, and enough for the lengths that are practical to store
+	if (retval->key_size <= 8) {
+		size_t size = (retval->bits + 1) * length;
+		retval->counts64 = calloc(size, sizeof(uint64_t));
+		
+		for (size_t i = 0; i < size; i++) retval->counts64[i] = retval->counts[i];
+	}
+	
+	return retval;
+}
+
+void rank_table_destroy(RankTable* table) {
+	free(table->counts);
+	free(table->counts64);
+	free(table);
+}
+
+size_t rank_key_size(const RankTable* table) {
+	return table->key_size;
+}
+
+// Ranks a packed bitface string. Only the set bits are visited:
+// each adds the number of valid strings with the same prefix and a zero in its place.
+// The rank is written as key_size little endian bytes.
+void rank_encode(const RankTable* table, const char* bitface, uint8_t* buffer) {
+	size_t bytes = bitface_key_size(table->length);
+	RankValue rank = 0;
+	uint64_t rank64 = 0;
+	int c = 0;
+	
+	for (size_t i = 0; i < bytes; i++) {
+		unsigned int value = (uint8_t) bitface[i];
+		
+		while (value) {
+			int bit = (i << 3) + __builtin_ctz(value);
+			value &= value - 1;
+			
+			if (table->counts64 != NULL) rank64 += RANK_COUNT64(table, bit + 1, c);
+			else rank += RANK_COUNT(table, bit + 1, c);
+			c++;
+		}
+	}
+	
+	if (table->counts64 != NULL) rank = rank64;
+	
+	for (size_t i = 0; i < table->key_size; i++) {
+		buffer[i] = rank & 0xFF;
+		rank >>= 8;
+	}
+}
+
+// Rebuilds the packed bitface string of a 64 bit rank, one bit at a time.
+// Decoding a whole 5 bit slot at once, by searching a table of each slot value's
+// lowest rank, was tried and measured no faster: every slot still waits on the loads
+// of the one before it, which costs as much as the mispredicted bits here.
+void rank_decode64(const RankTable* table, uint64_t rank, char* bitface) {
+	int set_bits = table->length - 1;
+	int c = 0;
+	
+	for (int bit = 0; bit < table->bits && c < set_bits; bit++) {
+		uint64_t zero_count = RANK_COUNT64(table, bit + 1, c);
+		
+		if (rank < zero_count) continue;
+		
+		rank -= zero_count;
+		bitface[bit >> 3] |= 1 << (bit & 7);
+		c++;
+	}
+}
+
+// Rebuilds the packed bitface string of a rank, one bit at a time,
+// until all n-1 bits are set
+void rank_decode(const RankTable* table, const uint8_t* buffer, char* bitface) {
+	RankValue rank = 0;
+	int set_bits = table->length - 1;
+	int c = 0;
+	
+	for (size_t i = table->key_size; i > 0; i--) {
+		rank = (rank << 8) | buffer[i - 1];
+	}
+	
+	memset(bitface, 0, bitface_key_size(table->length));
+	
+	if (table->counts64 != NULL) {
+		rank_decode64(table, rank, bitface);
+		return;
+	}
+	
+	for (int bit = 0; bit < table->bits && c < set_bits; bit++) {
+		RankValue zero_count = RANK_COUNT(table, bit + 1, c);
+		
+		if (rank < zero_count) continue;
+		
+		rank -= zero_count;
+		bitface[bit >> 3] |= 1 << (bit & 7);
+		c++;
+	}
+}
+
+// Ranks the first count keys of a list back to back.
+// Returns the number of bytes written.
+size_t rank_encode_keys(const RankTable* table, const KeyList* keys, uint64_t count, uint8_t* buffer, uint8_t* places) {
+	size_t raw_size = bitface_key_size(table->length);
+	char bitface[raw_size];
+	
+	for (uint64_t i = 0; i < count; i++) {
+		memset(bitface, 0, raw_size);
+		
+		bitface_pack(key_list_get(keys, i), table->length, bitface, places);
+		rank_encode(table, bitface, &buffer[i * table->key_size]);
+	}
+	
+	return count * table->key_size;
+}
+
+uint64_t rank_read_keys(InputStream* stream, const RankTable* table, KeyList* keys, uint64_t count) {
+	size_t in_buf_size = count * table->key_size;
+	uint8_t buffer[in_buf_size];
+	char bitface[bitface_key_size(table->length)];
+	
+	size_t read_count = input_stream_read(stream, buffer, in_buf_size);
+	
+	if (read_count == 0) return 0;
+	
+	size_t n_read = read_count / table->key_size;
+	
+	for (uint64_t i = 0; i < n_read; i++) {
+		rank_decode(table, &buffer[i * table->key_size], bitface);
+		
+		Key key = bitface_unpack(bitface, table->length);
+		key.source_index = 0;
+		key_list_set(keys, i, &key);
+	}
+	
+	return n_read;
+}
+
+// The file holds the length byte followed by the ranks
+uint64_t rank_read_count(InputStream* stream, const RankTable* table) {
+	uint64_t size = input_stream_get_size(stream);
+	
+	return (size - 1) / table->key_size;
+}
+
+void rank_write_keys(OutputStream* stream, const RankTable* table, KeyList* keys, uint64_t count, uint8_t* places) {
+	if (count < 1) return;
+	
+	uint8_t buffer[table->key_size];
+	size_t raw_size = bitface_key_size(table->length);
+	char bitface[raw_size];
+	
+	for (uint64_t i = 0; i < count; i++) {
+		memset(bitface, 0, raw_size);
+		
+		bitface_pack(key_list_get(keys, i), table->length, bitface, places);
+		rank_encode(table, bitface, buffer);
+		
+		output_stream_write(stream, buffer, table->key_size);
+	}
+}
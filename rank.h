@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <stdint.h>
+#include "key.h"
+#include "key_list.h"
+#include "input_stream.h"
+#include "output_stream.h"
+
+#ifndef RANK_H
+#define RANK_H
+
+// Lengths a rank table can be built for
+#define RANK_MIN_LENGTH 3
+#define RANK_MAX_LENGTH 30
+
+// Ranks need more than 64 bits above n=20
+typedef unsigned __int128 RankValue;
+
+// Counts of the valid bitface strings of one length, used to rank and unrank them
+typedef struct {
+	uint8_t length;
+	int bits; // Bits in a bitface string
+	size_t key_size; // Bytes in a rank
+	RankValue* counts; // Valid completions from each bit position with each number of set bits
+	uint64_t* counts64; // The same counts when every rank fits in 64 bits (up to n=20), else NULL
+} RankTable;
+
+RankTable* rank_table_create(uint8_t length);
+void rank_table_destroy(RankTable* table);
+
+size_t rank_key_size(const RankTable* table);
+void rank_encode(const RankTable* table, const char* bitface, uint8_t* buffer);
+void rank_decode(const RankTable* table, const uint8_t* buffer, char* bitface);
+
+size_t rank_encode_keys(const RankTable* table, const KeyList* keys, uint64_t count, uint8_t* buffer, uint8_t* places);
+uint64_t rank_read_keys(InputStream* stream, const RankTable* table, KeyList* output_keys, uint64_t count);
+uint64_t rank_read_count(InputStream* stream, const RankTable* table);
+
+void rank_write_keys(OutputStream* stream, const RankTable* table, KeyList* keys, uint64_t count, uint8_t* places);
+
+#endif
@@ -30,6 +30,22 @@ Reader* reader_create(char* filename, ReaderMode mode) {
 			if (input_stream_is_compressed(retval->stream)) printf(" with compression");
 			printf(".\n");
 			break;
+		case ReadRank:
+			printf("Starting file reader in Rank mode.\n");
+			if (!input_stream_read_raw(retval->stream, &retval->length, 1)) {
+				printf("Failed to read length data\n");
+				free(retval);
+				return NULL;
+			}
+			if (retval->length < RANK_MIN_LENGTH || retval->length > RANK_MAX_LENGTH) {
+				printf("Invalid length %d in rank file\n", retval->length);
+				input_stream_destroy(retval->stream);
+				free(retval);
+				return NULL;
+			}
+			retval->rank_table = rank_table_create(retval->length);
+			retval->count = rank_read_count(retval->stream, retval->rank_table);
+			break;
 	}
 	
 	return retval;
@@ -37,6 +53,7 @@ Reader* reader_create(char* filename, ReaderMode mode) {
 
 void reader_destroy(Reader* reader) {
 	input_stream_destroy(reader->stream);
+	if (reader->rank_table != NULL) rank_table_destroy(reader->rank_table);
 	
 	free(reader);
 }
@@ -49,7 +66,7 @@ uint64_t reader_get_count(Reader* reader) {
 	return reader->count;
 }
 
-uint64_t reader_read_keys(Reader* reader, Key* output_keys) {
+uint64_t reader_read_keys(Reader* reader, KeyList* output_keys) {
 	uint64_t n_read = 0;
 	
 	switch (reader->mode) {
@@ -59,7 +76,12 @@ uint64_t reader_read_keys(Reader* reader, Key* output_keys) {
 		case ReadPCube:
 			n_read = pcube_read_keys(reader->stream, output_keys, READER_MAX_COUNT);
 			break;
+		case ReadRank:
+			n_read = rank_read_keys(reader->stream, reader->rank_table, output_keys, READER_MAX_COUNT);
+			break;
 	}
 	
+	output_keys->count = n_read;
+	
 	return n_read;
 }
@@ -2,20 +2,23 @@
 #include <stdint.h>
 
 #include "key.h"
+#include "key_list.h"
 #include "input_stream.h"
+#include "rank.h"
 
 #ifndef READER_H
 #define READER_H
 
 #define READER_MAX_COUNT 10000
 
-typedef enum {ReadBitFace, ReadPCube} ReaderMode;
+typedef enum {ReadBitFace, ReadPCube, ReadRank} ReaderMode;
 
 typedef struct {
 	InputStream* stream;
 	ReaderMode mode;
 	uint8_t length;
 	uint64_t count;
+	RankTable* rank_table; // Only in rank mode
 } Reader;
 
 Reader* reader_create(char* filename, ReaderMode mode);
@@ -23,6 +26,6 @@ void reader_destroy(Reader* reader);
 
 uint8_t reader_get_n(Reader* reader);
 uint64_t reader_get_count(Reader* reader);
-uint64_t reader_read_keys(Reader* reader, Key* output_keys);
+uint64_t reader_read_keys(Reader* reader, KeyList* output_keys);
 
 #endif
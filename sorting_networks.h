@@ -0,0 +1,394 @@
+#ifndef SORTING_NETWORKS_H
+#define SORTING_NETWORKS_H
+
+// Sorting network definitions shared by the scalar and vector sorts.
+// Generated by tools/network_gen.c (make networks), do not edit by hand.
+// Each list calls SWAP(a, b) for every comparator in order, with one line per
+// layer of comparators that touch distinct elements.
+
+// Calls X(n) for every length with a network
+#define SORTING_NETWORKS(X) \
+	X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16) X(17) X(18) X(19) X(20) X(21) X(22) X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30)
+
+// 1 comparators in 1 layers, stored
+#define NETWORK2(SWAP) \
+	SWAP(0, 1)
+
+// 3 comparators in 3 layers, stored
+#define NETWORK3(SWAP) \
+	SWAP(0, 2) \
+	SWAP(0, 1) \
+	SWAP(1, 2)
+
+// 5 comparators in 3 layers, stored
+#define NETWORK4(SWAP) \
+	SWAP(0, 2) SWAP(1, 3) \
+	SWAP(0, 1) SWAP(2, 3) \
+	SWAP(1, 2)
+
+// 9 comparators in 5 layers, stored
+#define NETWORK5(SWAP) \
+	SWAP(0, 3) SWAP(1, 4) \
+	SWAP(0, 2) SWAP(1, 3) \
+	SWAP(0, 1) SWAP(2, 4) \
+	SWAP(1, 2) SWAP(3, 4) \
+	SWAP(2, 3)
+
+// 12 comparators in 5 layers, stored
+#define NETWORK6(SWAP) \
+	SWAP(0, 5) SWAP(1, 3) SWAP(2, 4) \
+	SWAP(1, 2) SWAP(3, 4) \
+	SWAP(0, 3) SWAP(2, 5) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) \
+	SWAP(1, 2) SWAP(3, 4)
+
+// 16 comparators in 6 layers, stored
+#define NETWORK7(SWAP) \
+	SWAP(0, 6) SWAP(2, 3) SWAP(4, 5) \
+	SWAP(0, 2) SWAP(1, 4) SWAP(3, 6) \
+	SWAP(0, 1) SWAP(2, 5) SWAP(3, 4) \
+	SWAP(1, 2) SWAP(4, 6) \
+	SWAP(2, 3) SWAP(4, 5) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 6)
+
+// 19 comparators in 6 layers, stored
+#define NETWORK8(SWAP) \
+	SWAP(0, 2) SWAP(1, 3) SWAP(4, 6) SWAP(5, 7) \
+	SWAP(0, 4) SWAP(1, 5) SWAP(2, 6) SWAP(3, 7) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) \
+	SWAP(2, 4) SWAP(3, 5) \
+	SWAP(1, 4) SWAP(3, 6) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 6)
+
+// 25 comparators in 7 layers, stored
+#define NETWORK9(SWAP) \
+	SWAP(0, 3) SWAP(1, 7) SWAP(2, 5) SWAP(4, 8) \
+	SWAP(0, 7) SWAP(2, 4) SWAP(3, 8) SWAP(5, 6) \
+	SWAP(0, 2) SWAP(1, 3) SWAP(4, 5) SWAP(7, 8) \
+	SWAP(1, 4) SWAP(3, 6) SWAP(5, 7) \
+	SWAP(0, 1) SWAP(2, 4) SWAP(3, 5) SWAP(6, 8) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 6)
+
+// 29 comparators in 8 layers, stored
+#define NETWORK10(SWAP) \
+	SWAP(0, 8) SWAP(1, 9) SWAP(2, 7) SWAP(3, 5) SWAP(4, 6) \
+	SWAP(0, 2) SWAP(1, 4) SWAP(5, 8) SWAP(7, 9) \
+	SWAP(0, 3) SWAP(2, 4) SWAP(5, 7) SWAP(6, 9) \
+	SWAP(0, 1) SWAP(3, 6) SWAP(8, 9) \
+	SWAP(1, 5) SWAP(2, 3) SWAP(4, 8) SWAP(6, 7) \
+	SWAP(1, 2) SWAP(3, 5) SWAP(4, 6) SWAP(7, 8) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) \
+	SWAP(3, 4) SWAP(5, 6)
+
+// 35 comparators in 8 layers, stored
+#define NETWORK11(SWAP) \
+	SWAP(0, 9) SWAP(1, 6) SWAP(2, 4) SWAP(3, 7) SWAP(5, 8) \
+	SWAP(0, 1) SWAP(3, 5) SWAP(4, 10) SWAP(6, 9) SWAP(7, 8) \
+	SWAP(1, 3) SWAP(2, 5) SWAP(4, 7) SWAP(8, 10) \
+	SWAP(0, 4) SWAP(1, 2) SWAP(3, 7) SWAP(5, 9) SWAP(6, 8) \
+	SWAP(0, 1) SWAP(2, 6) SWAP(4, 5) SWAP(7, 8) SWAP(9, 10) \
+	SWAP(2, 4) SWAP(3, 6) SWAP(5, 7) SWAP(8, 9) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7)
+
+// 39 comparators in 9 layers, stored
+#define NETWORK12(SWAP) \
+	SWAP(0, 8) SWAP(1, 7) SWAP(2, 6) SWAP(3, 11) SWAP(4, 10) SWAP(5, 9) \
+	SWAP(0, 1) SWAP(2, 5) SWAP(3, 4) SWAP(6, 9) SWAP(7, 8) SWAP(10, 11) \
+	SWAP(0, 2) SWAP(1, 6) SWAP(5, 10) SWAP(9, 11) \
+	SWAP(0, 3) SWAP(1, 2) SWAP(4, 6) SWAP(5, 7) SWAP(8, 11) SWAP(9, 10) \
+	SWAP(1, 4) SWAP(3, 5) SWAP(6, 8) SWAP(7, 10) \
+	SWAP(1, 3) SWAP(2, 5) SWAP(6, 9) SWAP(8, 10) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) \
+	SWAP(4, 6) SWAP(5, 7) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8)
+
+// 45 comparators in 10 layers, stored
+#define NETWORK13(SWAP) \
+	SWAP(0, 12) SWAP(1, 10) SWAP(2, 9) SWAP(3, 7) SWAP(5, 11) SWAP(6, 8) \
+	SWAP(1, 6) SWAP(2, 3) SWAP(4, 11) SWAP(7, 9) SWAP(8, 10) \
+	SWAP(0, 4) SWAP(1, 2) SWAP(3, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) \
+	SWAP(4, 6) SWAP(5, 9) SWAP(8, 11) SWAP(10, 12) \
+	SWAP(0, 5) SWAP(3, 8) SWAP(4, 7) SWAP(6, 11) SWAP(9, 10) \
+	SWAP(0, 1) SWAP(2, 5) SWAP(6, 9) SWAP(7, 8) SWAP(10, 11) \
+	SWAP(1, 3) SWAP(2, 4) SWAP(5, 6) SWAP(9, 10) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 7) SWAP(6, 8) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) \
+	SWAP(3, 4) SWAP(5, 6)
+
+// 51 comparators in 10 layers, stored
+#define NETWORK14(SWAP) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) \
+	SWAP(0, 2) SWAP(1, 3) SWAP(4, 8) SWAP(5, 9) SWAP(10, 12) SWAP(11, 13) \
+	SWAP(0, 4) SWAP(1, 2) SWAP(3, 7) SWAP(5, 8) SWAP(6, 10) SWAP(9, 13) SWAP(11, 12) \
+	SWAP(0, 6) SWAP(1, 5) SWAP(3, 9) SWAP(4, 10) SWAP(7, 13) SWAP(8, 12) \
+	SWAP(2, 10) SWAP(3, 11) SWAP(4, 6) SWAP(7, 9) \
+	SWAP(1, 3) SWAP(2, 8) SWAP(5, 11) SWAP(6, 7) SWAP(10, 12) \
+	SWAP(1, 4) SWAP(2, 6) SWAP(3, 5) SWAP(7, 11) SWAP(8, 10) SWAP(9, 12) \
+	SWAP(2, 4) SWAP(3, 6) SWAP(5, 8) SWAP(7, 10) SWAP(9, 11) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) \
+	SWAP(6, 7)
+
+// 56 comparators in 10 layers, pruned from 16
+#define NETWORK15(SWAP) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) \
+	SWAP(0, 2) SWAP(4, 6) SWAP(8, 10) SWAP(12, 14) SWAP(1, 3) SWAP(5, 7) SWAP(9, 11) \
+	SWAP(0, 4) SWAP(8, 12) SWAP(1, 5) SWAP(9, 13) SWAP(2, 6) SWAP(10, 14) SWAP(3, 7) \
+	SWAP(0, 8) SWAP(1, 9) SWAP(2, 10) SWAP(3, 11) SWAP(4, 12) SWAP(5, 13) SWAP(6, 14) \
+	SWAP(5, 10) SWAP(6, 9) SWAP(3, 12) SWAP(13, 14) SWAP(7, 11) SWAP(1, 2) SWAP(4, 8) \
+	SWAP(1, 4) SWAP(7, 13) SWAP(2, 8) SWAP(11, 14) SWAP(5, 6) SWAP(9, 10) \
+	SWAP(2, 4) SWAP(11, 13) SWAP(3, 8) SWAP(7, 12) \
+	SWAP(6, 8) SWAP(10, 12) SWAP(3, 5) SWAP(7, 9) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) \
+	SWAP(6, 7) SWAP(8, 9)
+
+// 60 comparators in 10 layers, stored
+#define NETWORK16(SWAP) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) \
+	SWAP(0, 2) SWAP(4, 6) SWAP(8, 10) SWAP(12, 14) SWAP(1, 3) SWAP(5, 7) SWAP(9, 11) SWAP(13, 15) \
+	SWAP(0, 4) SWAP(8, 12) SWAP(1, 5) SWAP(9, 13) SWAP(2, 6) SWAP(10, 14) SWAP(3, 7) SWAP(11, 15) \
+	SWAP(0, 8) SWAP(1, 9) SWAP(2, 10) SWAP(3, 11) SWAP(4, 12) SWAP(5, 13) SWAP(6, 14) SWAP(7, 15) \
+	SWAP(5, 10) SWAP(6, 9) SWAP(3, 12) SWAP(13, 14) SWAP(7, 11) SWAP(1, 2) SWAP(4, 8) \
+	SWAP(1, 4) SWAP(7, 13) SWAP(2, 8) SWAP(11, 14) SWAP(5, 6) SWAP(9, 10) \
+	SWAP(2, 4) SWAP(11, 13) SWAP(3, 8) SWAP(7, 12) \
+	SWAP(6, 8) SWAP(10, 12) SWAP(3, 5) SWAP(7, 9) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) \
+	SWAP(6, 7) SWAP(8, 9)
+
+// 71 comparators in 12 layers, stored
+#define NETWORK17(SWAP) \
+	SWAP(0, 11) SWAP(1, 15) SWAP(2, 10) SWAP(3, 5) SWAP(4, 6) SWAP(8, 12) SWAP(9, 16) SWAP(13, 14) \
+	SWAP(0, 6) SWAP(1, 13) SWAP(2, 8) SWAP(4, 14) SWAP(5, 15) SWAP(7, 11) \
+	SWAP(0, 8) SWAP(3, 7) SWAP(4, 9) SWAP(6, 16) SWAP(10, 11) SWAP(12, 14) \
+	SWAP(0, 2) SWAP(1, 4) SWAP(5, 6) SWAP(7, 13) SWAP(8, 9) SWAP(10, 12) SWAP(11, 14) SWAP(15, 16) \
+	SWAP(0, 3) SWAP(2, 5) SWAP(6, 11) SWAP(7, 10) SWAP(9, 13) SWAP(12, 15) SWAP(14, 16) \
+	SWAP(0, 1) SWAP(3, 4) SWAP(5, 10) SWAP(6, 9) SWAP(7, 8) SWAP(11, 15) SWAP(13, 14) \
+	SWAP(1, 2) SWAP(3, 7) SWAP(4, 8) SWAP(6, 12) SWAP(11, 13) SWAP(14, 15) \
+	SWAP(1, 3) SWAP(2, 7) SWAP(4, 5) SWAP(9, 11) SWAP(10, 12) SWAP(13, 14) \
+	SWAP(2, 3) SWAP(4, 6) SWAP(5, 7) SWAP(8, 10) \
+	SWAP(3, 4) SWAP(6, 8) SWAP(7, 9) SWAP(10, 12) \
+	SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) \
+	SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13)
+
+// 77 comparators in 12 layers, stored
+#define NETWORK18(SWAP) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) \
+	SWAP(0, 2) SWAP(1, 3) SWAP(4, 12) SWAP(5, 13) SWAP(6, 8) SWAP(9, 11) SWAP(14, 16) SWAP(15, 17) \
+	SWAP(0, 14) SWAP(1, 16) SWAP(2, 15) SWAP(3, 17) \
+	SWAP(0, 6) SWAP(1, 10) SWAP(2, 9) SWAP(7, 16) SWAP(8, 15) SWAP(11, 17) \
+	SWAP(1, 4) SWAP(3, 9) SWAP(5, 7) SWAP(8, 14) SWAP(10, 12) SWAP(13, 16) \
+	SWAP(0, 1) SWAP(2, 5) SWAP(3, 13) SWAP(4, 14) SWAP(7, 9) SWAP(8, 10) SWAP(12, 15) SWAP(16, 17) \
+	SWAP(1, 2) SWAP(3, 5) SWAP(4, 6) SWAP(11, 13) SWAP(12, 14) SWAP(15, 16) \
+	SWAP(4, 8) SWAP(5, 12) SWAP(6, 10) SWAP(7, 11) SWAP(9, 13) \
+	SWAP(1, 4) SWAP(2, 8) SWAP(3, 6) SWAP(5, 7) SWAP(9, 15) SWAP(10, 12) SWAP(11, 14) SWAP(13, 16) \
+	SWAP(2, 4) SWAP(5, 8) SWAP(6, 10) SWAP(7, 11) SWAP(9, 12) SWAP(13, 15) \
+	SWAP(3, 5) SWAP(6, 8) SWAP(7, 10) SWAP(9, 11) SWAP(12, 14) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 14)
+
+// 85 comparators in 12 layers, stored
+#define NETWORK19(SWAP) \
+	SWAP(0, 12) SWAP(1, 4) SWAP(2, 8) SWAP(3, 5) SWAP(6, 17) SWAP(7, 11) SWAP(9, 14) SWAP(10, 13) SWAP(15, 16) \
+	SWAP(0, 2) SWAP(1, 7) SWAP(3, 6) SWAP(4, 11) SWAP(5, 17) SWAP(8, 12) SWAP(10, 15) SWAP(13, 16) SWAP(14, 18) \
+	SWAP(3, 10) SWAP(4, 14) SWAP(5, 15) SWAP(6, 13) SWAP(7, 9) SWAP(11, 17) SWAP(16, 18) \
+	SWAP(0, 7) SWAP(1, 10) SWAP(4, 6) SWAP(9, 15) SWAP(11, 16) SWAP(12, 17) SWAP(13, 14) \
+	SWAP(0, 3) SWAP(2, 6) SWAP(5, 7) SWAP(8, 11) SWAP(12, 16) \
+	SWAP(1, 8) SWAP(2, 9) SWAP(3, 4) SWAP(6, 15) SWAP(7, 13) SWAP(10, 11) SWAP(12, 18) \
+	SWAP(1, 3) SWAP(2, 5) SWAP(6, 9) SWAP(7, 12) SWAP(8, 10) SWAP(11, 14) SWAP(17, 18) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 8) SWAP(6, 10) SWAP(9, 12) SWAP(14, 15) SWAP(16, 17) \
+	SWAP(1, 2) SWAP(5, 8) SWAP(6, 7) SWAP(9, 11) SWAP(10, 13) SWAP(14, 16) SWAP(15, 17) \
+	SWAP(3, 6) SWAP(4, 5) SWAP(7, 9) SWAP(8, 10) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 13) SWAP(12, 14) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15)
+
+// 91 comparators in 12 layers, stored
+#define NETWORK20(SWAP) \
+	SWAP(0, 3) SWAP(1, 7) SWAP(2, 5) SWAP(4, 8) SWAP(6, 9) SWAP(10, 13) SWAP(11, 15) SWAP(12, 18) SWAP(14, 17) SWAP(16, 19) \
+	SWAP(0, 14) SWAP(1, 11) SWAP(2, 16) SWAP(3, 17) SWAP(4, 12) SWAP(5, 19) SWAP(6, 10) SWAP(7, 15) SWAP(8, 18) SWAP(9, 13) \
+	SWAP(0, 4) SWAP(1, 2) SWAP(3, 8) SWAP(5, 7) SWAP(11, 16) SWAP(12, 14) SWAP(15, 19) SWAP(17, 18) \
+	SWAP(1, 6) SWAP(2, 12) SWAP(3, 5) SWAP(4, 11) SWAP(7, 17) SWAP(8, 15) SWAP(13, 18) SWAP(14, 16) \
+	SWAP(0, 1) SWAP(2, 6) SWAP(7, 10) SWAP(9, 12) SWAP(13, 17) SWAP(18, 19) \
+	SWAP(1, 6) SWAP(5, 9) SWAP(7, 11) SWAP(8, 12) SWAP(10, 14) SWAP(13, 18) \
+	SWAP(3, 5) SWAP(4, 7) SWAP(8, 10) SWAP(9, 11) SWAP(12, 15) SWAP(14, 16) \
+	SWAP(1, 3) SWAP(2, 4) SWAP(5, 7) SWAP(6, 10) SWAP(9, 13) SWAP(12, 14) SWAP(15, 17) SWAP(16, 18) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(15, 16) SWAP(17, 18) \
+	SWAP(2, 3) SWAP(4, 6) SWAP(5, 8) SWAP(7, 9) SWAP(10, 12) SWAP(11, 14) SWAP(13, 15) SWAP(16, 17) \
+	SWAP(4, 5) SWAP(6, 8) SWAP(7, 10) SWAP(9, 12) SWAP(11, 13) SWAP(14, 15) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16)
+
+// 99 comparators in 15 layers, stored
+#define NETWORK21(SWAP) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) \
+	SWAP(0, 2) SWAP(1, 3) SWAP(4, 6) SWAP(5, 7) SWAP(8, 10) SWAP(9, 11) SWAP(12, 14) SWAP(13, 15) SWAP(16, 18) SWAP(17, 19) \
+	SWAP(0, 8) SWAP(1, 9) SWAP(2, 10) SWAP(3, 11) SWAP(4, 12) SWAP(5, 13) SWAP(6, 14) SWAP(7, 15) \
+	SWAP(0, 4) SWAP(1, 5) SWAP(3, 7) SWAP(6, 20) SWAP(8, 12) SWAP(9, 13) SWAP(10, 14) SWAP(15, 19) \
+	SWAP(2, 6) SWAP(3, 18) SWAP(7, 20) \
+	SWAP(2, 16) SWAP(3, 6) SWAP(5, 18) SWAP(7, 17) SWAP(11, 20) \
+	SWAP(0, 2) SWAP(3, 8) SWAP(6, 12) SWAP(7, 10) SWAP(9, 16) SWAP(11, 15) SWAP(13, 17) SWAP(14, 18) SWAP(19, 20) \
+	SWAP(1, 7) SWAP(2, 3) SWAP(4, 9) SWAP(10, 11) SWAP(13, 16) SWAP(15, 18) SWAP(17, 19) \
+	SWAP(1, 4) SWAP(5, 10) SWAP(6, 13) SWAP(7, 8) SWAP(11, 14) SWAP(12, 16) SWAP(15, 17) SWAP(18, 19) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 6) SWAP(10, 12) SWAP(11, 13) SWAP(14, 16) SWAP(17, 18) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) \
+	SWAP(6, 7) SWAP(8, 9) SWAP(15, 16) \
+	SWAP(4, 6) SWAP(7, 8) SWAP(9, 12) SWAP(13, 15) \
+	SWAP(3, 4) SWAP(5, 7) SWAP(8, 10) SWAP(9, 11) SWAP(12, 14) \
+	SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 14)
+
+// 106 comparators in 13 layers, stored
+#define NETWORK22(SWAP) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) \
+	SWAP(0, 2) SWAP(1, 3) SWAP(4, 6) SWAP(5, 7) SWAP(8, 12) SWAP(9, 13) SWAP(14, 16) SWAP(15, 17) SWAP(18, 20) SWAP(19, 21) \
+	SWAP(0, 4) SWAP(1, 5) SWAP(2, 6) SWAP(3, 7) SWAP(8, 10) SWAP(9, 12) SWAP(11, 13) SWAP(14, 18) SWAP(15, 19) SWAP(16, 20) SWAP(17, 21) \
+	SWAP(0, 14) SWAP(1, 15) SWAP(2, 18) SWAP(3, 19) SWAP(4, 16) SWAP(5, 17) SWAP(6, 20) SWAP(7, 21) SWAP(9, 11) SWAP(10, 12) \
+	SWAP(2, 8) SWAP(3, 11) SWAP(6, 9) SWAP(10, 18) SWAP(12, 15) SWAP(13, 19) \
+	SWAP(0, 2) SWAP(1, 10) SWAP(3, 16) SWAP(5, 18) SWAP(6, 14) SWAP(7, 15) SWAP(8, 12) SWAP(9, 13) SWAP(11, 20) SWAP(19, 21) \
+	SWAP(2, 6) SWAP(3, 10) SWAP(4, 8) SWAP(5, 12) SWAP(9, 16) SWAP(11, 18) SWAP(13, 17) SWAP(15, 19) \
+	SWAP(1, 4) SWAP(7, 13) SWAP(8, 14) SWAP(9, 12) SWAP(17, 20) \
+	SWAP(1, 2) SWAP(3, 8) SWAP(4, 6) SWAP(7, 11) SWAP(10, 14) SWAP(13, 18) SWAP(15, 17) SWAP(19, 20) \
+	SWAP(2, 4) SWAP(5, 10) SWAP(7, 9) SWAP(11, 16) SWAP(12, 14) SWAP(17, 19) \
+	SWAP(5, 6) SWAP(7, 8) SWAP(9, 11) SWAP(10, 12) SWAP(13, 14) SWAP(15, 16) \
+	SWAP(3, 5) SWAP(6, 7) SWAP(8, 10) SWAP(9, 12) SWAP(11, 13) SWAP(14, 15) SWAP(16, 18) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16) SWAP(17, 18)
+
+// 114 comparators in 14 layers, stored
+#define NETWORK23(SWAP) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) \
+	SWAP(0, 2) SWAP(1, 3) SWAP(4, 6) SWAP(5, 7) SWAP(8, 10) SWAP(9, 11) SWAP(12, 14) SWAP(13, 15) SWAP(16, 18) SWAP(17, 19) SWAP(21, 22) \
+	SWAP(0, 4) SWAP(1, 5) SWAP(2, 6) SWAP(3, 7) SWAP(8, 12) SWAP(9, 13) SWAP(10, 14) SWAP(11, 15) SWAP(17, 21) SWAP(18, 20) SWAP(19, 22) \
+	SWAP(0, 8) SWAP(1, 9) SWAP(2, 10) SWAP(3, 11) SWAP(4, 12) SWAP(5, 13) SWAP(6, 14) SWAP(7, 15) \
+	SWAP(1, 2) SWAP(5, 18) SWAP(7, 19) SWAP(9, 16) SWAP(10, 21) SWAP(12, 20) SWAP(15, 22) \
+	SWAP(5, 9) SWAP(6, 7) SWAP(10, 18) SWAP(11, 21) SWAP(12, 17) SWAP(13, 20) SWAP(14, 15) \
+	SWAP(3, 17) SWAP(6, 16) SWAP(7, 14) SWAP(8, 12) SWAP(15, 19) SWAP(20, 21) \
+	SWAP(3, 4) SWAP(5, 8) SWAP(6, 10) SWAP(9, 12) SWAP(13, 16) SWAP(14, 15) SWAP(17, 18) SWAP(19, 21) \
+	SWAP(0, 5) SWAP(1, 8) SWAP(2, 12) SWAP(3, 9) SWAP(4, 10) SWAP(7, 13) SWAP(11, 17) SWAP(14, 16) SWAP(18, 20) \
+	SWAP(2, 6) SWAP(3, 5) SWAP(4, 8) SWAP(7, 11) SWAP(10, 12) SWAP(13, 18) SWAP(14, 17) SWAP(15, 20) \
+	SWAP(1, 3) SWAP(2, 5) SWAP(6, 9) SWAP(7, 10) SWAP(11, 13) SWAP(12, 14) SWAP(15, 18) SWAP(16, 17) SWAP(19, 20) \
+	SWAP(2, 3) SWAP(4, 6) SWAP(8, 9) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16) SWAP(17, 19) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(12, 13) SWAP(14, 15) SWAP(17, 18) \
+	SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(16, 17)
+
+// 120 comparators in 13 layers, stored
+#define NETWORK24(SWAP) \
+	SWAP(0, 20) SWAP(1, 12) SWAP(2, 16) SWAP(3, 23) SWAP(4, 6) SWAP(5, 10) SWAP(7, 21) SWAP(8, 14) SWAP(9, 15) SWAP(11, 22) SWAP(13, 18) SWAP(17, 19) \
+	SWAP(0, 3) SWAP(1, 11) SWAP(2, 7) SWAP(4, 17) SWAP(5, 13) SWAP(6, 19) SWAP(8, 9) SWAP(10, 18) SWAP(12, 22) SWAP(14, 15) SWAP(16, 21) SWAP(20, 23) \
+	SWAP(0, 1) SWAP(2, 4) SWAP(3, 12) SWAP(5, 8) SWAP(6, 9) SWAP(7, 10) SWAP(11, 20) SWAP(13, 16) SWAP(14, 17) SWAP(15, 18) SWAP(19, 21) SWAP(22, 23) \
+	SWAP(2, 5) SWAP(4, 8) SWAP(6, 11) SWAP(7, 14) SWAP(9, 16) SWAP(12, 17) SWAP(15, 19) SWAP(18, 21) \
+	SWAP(1, 8) SWAP(3, 14) SWAP(4, 7) SWAP(9, 20) SWAP(10, 12) SWAP(11, 13) SWAP(15, 22) SWAP(16, 19) \
+	SWAP(0, 7) SWAP(1, 5) SWAP(3, 4) SWAP(6, 11) SWAP(8, 15) SWAP(9, 14) SWAP(10, 13) SWAP(12, 17) SWAP(16, 23) SWAP(18, 22) SWAP(19, 20) \
+	SWAP(0, 2) SWAP(1, 6) SWAP(4, 7) SWAP(5, 9) SWAP(8, 10) SWAP(13, 15) SWAP(14, 18) SWAP(16, 19) SWAP(17, 22) SWAP(21, 23) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 8) SWAP(7, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 16) SWAP(15, 17) SWAP(18, 19) SWAP(20, 21) \
+	SWAP(1, 2) SWAP(3, 6) SWAP(4, 10) SWAP(7, 8) SWAP(9, 11) SWAP(12, 14) SWAP(13, 19) SWAP(15, 16) SWAP(17, 20) SWAP(21, 22) \
+	SWAP(2, 3) SWAP(5, 10) SWAP(6, 7) SWAP(8, 9) SWAP(13, 18) SWAP(14, 15) SWAP(16, 17) SWAP(20, 21) \
+	SWAP(3, 4) SWAP(5, 7) SWAP(10, 12) SWAP(11, 13) SWAP(16, 18) SWAP(19, 20) \
+	SWAP(4, 6) SWAP(8, 10) SWAP(9, 12) SWAP(11, 14) SWAP(13, 15) SWAP(17, 19) \
+	SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16) SWAP(17, 18)
+
+// 134 comparators in 15 layers, merged from 9 and 16
+#define NETWORK25(SWAP) \
+	SWAP(0, 3) SWAP(1, 7) SWAP(2, 5) SWAP(4, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16) SWAP(17, 18) SWAP(19, 20) SWAP(21, 22) SWAP(23, 24) \
+	SWAP(0, 7) SWAP(2, 4) SWAP(3, 8) SWAP(5, 6) SWAP(9, 11) SWAP(13, 15) SWAP(17, 19) SWAP(21, 23) SWAP(10, 12) SWAP(14, 16) SWAP(18, 20) SWAP(22, 24) \
+	SWAP(0, 2) SWAP(1, 3) SWAP(4, 5) SWAP(7, 8) SWAP(9, 13) SWAP(17, 21) SWAP(10, 14) SWAP(18, 22) SWAP(11, 15) SWAP(19, 23) SWAP(12, 16) SWAP(20, 24) \
+	SWAP(1, 4) SWAP(3, 6) SWAP(5, 7) SWAP(9, 17) SWAP(10, 18) SWAP(11, 19) SWAP(12, 20) SWAP(13, 21) SWAP(14, 22) SWAP(15, 23) SWAP(16, 24) \
+	SWAP(0, 1) SWAP(2, 4) SWAP(3, 5) SWAP(6, 8) SWAP(14, 19) SWAP(15, 18) SWAP(12, 21) SWAP(22, 23) SWAP(16, 20) SWAP(10, 11) SWAP(13, 17) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(10, 13) SWAP(16, 22) SWAP(11, 17) SWAP(20, 23) SWAP(14, 15) SWAP(18, 19) SWAP(8, 24) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 6) SWAP(11, 13) SWAP(20, 22) SWAP(12, 17) SWAP(16, 21) SWAP(7, 23) \
+	SWAP(15, 17) SWAP(19, 21) SWAP(12, 14) SWAP(16, 18) SWAP(6, 22) \
+	SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) \
+	SWAP(15, 16) SWAP(17, 18) SWAP(5, 21) SWAP(3, 19) SWAP(6, 14) SWAP(4, 20) \
+	SWAP(1, 17) SWAP(5, 13) SWAP(3, 11) SWAP(7, 15) SWAP(2, 18) SWAP(4, 12) SWAP(0, 16) \
+	SWAP(1, 9) SWAP(13, 17) SWAP(7, 11) SWAP(15, 19) SWAP(2, 10) SWAP(14, 18) SWAP(8, 16) SWAP(0, 4) \
+	SWAP(5, 9) SWAP(11, 13) SWAP(15, 17) SWAP(19, 21) SWAP(6, 10) SWAP(8, 12) SWAP(16, 20) SWAP(0, 2) \
+	SWAP(3, 5) SWAP(7, 9) SWAP(4, 6) SWAP(8, 10) SWAP(12, 14) SWAP(16, 18) SWAP(20, 22) SWAP(0, 1) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) SWAP(22, 23)
+
+// 141 comparators in 15 layers, merged from 10 and 16
+#define NETWORK26(SWAP) \
+	SWAP(0, 8) SWAP(1, 9) SWAP(2, 7) SWAP(3, 5) SWAP(4, 6) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) SWAP(22, 23) SWAP(24, 25) \
+	SWAP(0, 2) SWAP(1, 4) SWAP(5, 8) SWAP(7, 9) SWAP(10, 12) SWAP(14, 16) SWAP(18, 20) SWAP(22, 24) SWAP(11, 13) SWAP(15, 17) SWAP(19, 21) SWAP(23, 25) \
+	SWAP(0, 3) SWAP(2, 4) SWAP(5, 7) SWAP(6, 9) SWAP(10, 14) SWAP(18, 22) SWAP(11, 15) SWAP(19, 23) SWAP(12, 16) SWAP(20, 24) SWAP(13, 17) SWAP(21, 25) \
+	SWAP(0, 1) SWAP(3, 6) SWAP(8, 9) SWAP(10, 18) SWAP(11, 19) SWAP(12, 20) SWAP(13, 21) SWAP(14, 22) SWAP(15, 23) SWAP(16, 24) SWAP(17, 25) \
+	SWAP(1, 5) SWAP(2, 3) SWAP(4, 8) SWAP(6, 7) SWAP(15, 20) SWAP(16, 19) SWAP(13, 22) SWAP(23, 24) SWAP(17, 21) SWAP(11, 12) SWAP(14, 18) SWAP(9, 25) \
+	SWAP(1, 2) SWAP(3, 5) SWAP(4, 6) SWAP(7, 8) SWAP(11, 14) SWAP(17, 23) SWAP(12, 18) SWAP(21, 24) SWAP(15, 16) SWAP(19, 20) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(12, 14) SWAP(21, 23) SWAP(13, 18) SWAP(17, 22) SWAP(8, 24) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(16, 18) SWAP(20, 22) SWAP(13, 15) SWAP(17, 19) SWAP(7, 23) \
+	SWAP(13, 14) SWAP(15, 16) SWAP(17, 18) SWAP(19, 20) SWAP(21, 22) \
+	SWAP(16, 17) SWAP(18, 19) SWAP(6, 22) SWAP(4, 20) SWAP(7, 15) SWAP(5, 21) \
+	SWAP(2, 18) SWAP(6, 14) SWAP(4, 12) SWAP(0, 16) SWAP(3, 19) SWAP(5, 13) SWAP(1, 17) \
+	SWAP(2, 10) SWAP(14, 18) SWAP(8, 16) SWAP(0, 4) SWAP(3, 11) SWAP(15, 19) SWAP(9, 17) SWAP(1, 5) \
+	SWAP(6, 10) SWAP(8, 12) SWAP(16, 20) SWAP(0, 2) SWAP(7, 11) SWAP(9, 13) SWAP(17, 21) SWAP(1, 3) \
+	SWAP(4, 6) SWAP(8, 10) SWAP(12, 14) SWAP(16, 18) SWAP(20, 22) SWAP(5, 7) SWAP(9, 11) SWAP(13, 15) SWAP(17, 19) SWAP(21, 23) SWAP(1, 2) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16) SWAP(17, 18) SWAP(19, 20) SWAP(21, 22) SWAP(23, 24)
+
+// 150 comparators in 15 layers, merged from 11 and 16
+#define NETWORK27(SWAP) \
+	SWAP(0, 9) SWAP(1, 6) SWAP(2, 4) SWAP(3, 7) SWAP(5, 8) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16) SWAP(17, 18) SWAP(19, 20) SWAP(21, 22) SWAP(23, 24) SWAP(25, 26) \
+	SWAP(0, 1) SWAP(3, 5) SWAP(4, 10) SWAP(6, 9) SWAP(7, 8) SWAP(11, 13) SWAP(15, 17) SWAP(19, 21) SWAP(23, 25) SWAP(12, 14) SWAP(16, 18) SWAP(20, 22) SWAP(24, 26) \
+	SWAP(1, 3) SWAP(2, 5) SWAP(4, 7) SWAP(8, 10) SWAP(11, 15) SWAP(19, 23) SWAP(12, 16) SWAP(20, 24) SWAP(13, 17) SWAP(21, 25) SWAP(14, 18) SWAP(22, 26) \
+	SWAP(0, 4) SWAP(1, 2) SWAP(3, 7) SWAP(5, 9) SWAP(6, 8) SWAP(11, 19) SWAP(12, 20) SWAP(13, 21) SWAP(14, 22) SWAP(15, 23) SWAP(16, 24) SWAP(17, 25) SWAP(18, 26) \
+	SWAP(0, 1) SWAP(2, 6) SWAP(4, 5) SWAP(7, 8) SWAP(9, 10) SWAP(16, 21) SWAP(17, 20) SWAP(14, 23) SWAP(24, 25) SWAP(18, 22) SWAP(12, 13) SWAP(15, 19) \
+	SWAP(2, 4) SWAP(3, 6) SWAP(5, 7) SWAP(8, 9) SWAP(12, 15) SWAP(18, 24) SWAP(13, 19) SWAP(22, 25) SWAP(16, 17) SWAP(20, 21) SWAP(10, 26) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(13, 15) SWAP(22, 24) SWAP(14, 19) SWAP(18, 23) SWAP(9, 25) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(17, 19) SWAP(21, 23) SWAP(14, 16) SWAP(18, 20) SWAP(8, 24) \
+	SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) SWAP(22, 23) \
+	SWAP(17, 18) SWAP(19, 20) SWAP(7, 23) SWAP(5, 21) SWAP(0, 16) SWAP(6, 22) \
+	SWAP(3, 19) SWAP(7, 15) SWAP(5, 13) SWAP(1, 17) SWAP(4, 20) SWAP(8, 16) SWAP(6, 14) SWAP(2, 18) \
+	SWAP(3, 11) SWAP(15, 19) SWAP(9, 17) SWAP(1, 5) SWAP(4, 12) SWAP(16, 20) SWAP(10, 18) SWAP(2, 6) \
+	SWAP(7, 11) SWAP(9, 13) SWAP(17, 21) SWAP(1, 3) SWAP(0, 4) SWAP(8, 12) SWAP(10, 14) SWAP(18, 22) \
+	SWAP(5, 7) SWAP(9, 11) SWAP(13, 15) SWAP(17, 19) SWAP(21, 23) SWAP(2, 4) SWAP(6, 8) SWAP(10, 12) SWAP(14, 16) SWAP(18, 20) SWAP(22, 24) SWAP(0, 1) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) SWAP(22, 23) SWAP(24, 25)
+
+// 156 comparators in 15 layers, merged from 12 and 16
+#define NETWORK28(SWAP) \
+	SWAP(0, 8) SWAP(1, 7) SWAP(2, 6) SWAP(3, 11) SWAP(4, 10) SWAP(5, 9) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) SWAP(22, 23) SWAP(24, 25) SWAP(26, 27) \
+	SWAP(0, 1) SWAP(2, 5) SWAP(3, 4) SWAP(6, 9) SWAP(7, 8) SWAP(10, 11) SWAP(12, 14) SWAP(16, 18) SWAP(20, 22) SWAP(24, 26) SWAP(13, 15) SWAP(17, 19) SWAP(21, 23) SWAP(25, 27) \
+	SWAP(0, 2) SWAP(1, 6) SWAP(5, 10) SWAP(9, 11) SWAP(12, 16) SWAP(20, 24) SWAP(13, 17) SWAP(21, 25) SWAP(14, 18) SWAP(22, 26) SWAP(15, 19) SWAP(23, 27) \
+	SWAP(0, 3) SWAP(1, 2) SWAP(4, 6) SWAP(5, 7) SWAP(8, 11) SWAP(9, 10) SWAP(12, 20) SWAP(13, 21) SWAP(14, 22) SWAP(15, 23) SWAP(16, 24) SWAP(17, 25) SWAP(18, 26) SWAP(19, 27) \
+	SWAP(1, 4) SWAP(3, 5) SWAP(6, 8) SWAP(7, 10) SWAP(17, 22) SWAP(18, 21) SWAP(15, 24) SWAP(25, 26) SWAP(19, 23) SWAP(13, 14) SWAP(16, 20) SWAP(11, 27) \
+	SWAP(1, 3) SWAP(2, 5) SWAP(6, 9) SWAP(8, 10) SWAP(13, 16) SWAP(19, 25) SWAP(14, 20) SWAP(23, 26) SWAP(17, 18) SWAP(21, 22) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(14, 16) SWAP(23, 25) SWAP(15, 20) SWAP(19, 24) SWAP(10, 26) \
+	SWAP(4, 6) SWAP(5, 7) SWAP(18, 20) SWAP(22, 24) SWAP(15, 17) SWAP(19, 21) SWAP(9, 25) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(15, 16) SWAP(17, 18) SWAP(19, 20) SWAP(21, 22) SWAP(23, 24) \
+	SWAP(18, 19) SWAP(20, 21) SWAP(0, 16) SWAP(8, 24) SWAP(6, 22) SWAP(1, 17) SWAP(7, 23) \
+	SWAP(4, 20) SWAP(8, 16) SWAP(6, 14) SWAP(2, 18) SWAP(5, 21) SWAP(9, 17) SWAP(7, 15) SWAP(3, 19) \
+	SWAP(4, 12) SWAP(16, 20) SWAP(10, 18) SWAP(2, 6) SWAP(5, 13) SWAP(17, 21) SWAP(11, 19) SWAP(3, 7) \
+	SWAP(0, 4) SWAP(8, 12) SWAP(10, 14) SWAP(18, 22) SWAP(1, 5) SWAP(9, 13) SWAP(11, 15) SWAP(19, 23) \
+	SWAP(2, 4) SWAP(6, 8) SWAP(10, 12) SWAP(14, 16) SWAP(18, 20) SWAP(22, 24) SWAP(3, 5) SWAP(7, 9) SWAP(11, 13) SWAP(15, 17) SWAP(19, 21) SWAP(23, 25) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16) SWAP(17, 18) SWAP(19, 20) SWAP(21, 22) SWAP(23, 24) SWAP(25, 26)
+
+// 165 comparators in 15 layers, merged from 13 and 16
+#define NETWORK29(SWAP) \
+	SWAP(0, 12) SWAP(1, 10) SWAP(2, 9) SWAP(3, 7) SWAP(5, 11) SWAP(6, 8) SWAP(13, 14) SWAP(15, 16) SWAP(17, 18) SWAP(19, 20) SWAP(21, 22) SWAP(23, 24) SWAP(25, 26) SWAP(27, 28) \
+	SWAP(1, 6) SWAP(2, 3) SWAP(4, 11) SWAP(7, 9) SWAP(8, 10) SWAP(13, 15) SWAP(17, 19) SWAP(21, 23) SWAP(25, 27) SWAP(14, 16) SWAP(18, 20) SWAP(22, 24) SWAP(26, 28) \
+	SWAP(0, 4) SWAP(1, 2) SWAP(3, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 17) SWAP(21, 25) SWAP(14, 18) SWAP(22, 26) SWAP(15, 19) SWAP(23, 27) SWAP(16, 20) SWAP(24, 28) \
+	SWAP(4, 6) SWAP(5, 9) SWAP(8, 11) SWAP(10, 12) SWAP(13, 21) SWAP(14, 22) SWAP(15, 23) SWAP(16, 24) SWAP(17, 25) SWAP(18, 26) SWAP(19, 27) SWAP(20, 28) \
+	SWAP(0, 5) SWAP(3, 8) SWAP(4, 7) SWAP(6, 11) SWAP(9, 10) SWAP(18, 23) SWAP(19, 22) SWAP(16, 25) SWAP(26, 27) SWAP(20, 24) SWAP(14, 15) SWAP(17, 21) SWAP(12, 28) \
+	SWAP(0, 1) SWAP(2, 5) SWAP(6, 9) SWAP(7, 8) SWAP(10, 11) SWAP(14, 17) SWAP(20, 26) SWAP(15, 21) SWAP(24, 27) SWAP(18, 19) SWAP(22, 23) \
+	SWAP(1, 3) SWAP(2, 4) SWAP(5, 6) SWAP(9, 10) SWAP(15, 17) SWAP(24, 26) SWAP(16, 21) SWAP(20, 25) SWAP(11, 27) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 7) SWAP(6, 8) SWAP(19, 21) SWAP(23, 25) SWAP(16, 18) SWAP(20, 22) SWAP(10, 26) \
+	SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) SWAP(22, 23) SWAP(24, 25) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(19, 20) SWAP(21, 22) SWAP(1, 17) SWAP(9, 25) SWAP(7, 23) SWAP(2, 18) SWAP(0, 16) SWAP(8, 24) \
+	SWAP(5, 21) SWAP(9, 17) SWAP(7, 15) SWAP(3, 19) SWAP(6, 22) SWAP(10, 18) SWAP(8, 16) SWAP(4, 20) \
+	SWAP(5, 13) SWAP(17, 21) SWAP(11, 19) SWAP(3, 7) SWAP(6, 14) SWAP(18, 22) SWAP(12, 20) SWAP(4, 8) \
+	SWAP(1, 5) SWAP(9, 13) SWAP(11, 15) SWAP(19, 23) SWAP(2, 6) SWAP(10, 14) SWAP(12, 16) SWAP(20, 24) \
+	SWAP(3, 5) SWAP(7, 9) SWAP(11, 13) SWAP(15, 17) SWAP(19, 21) SWAP(23, 25) SWAP(0, 2) SWAP(4, 6) SWAP(8, 10) SWAP(12, 14) SWAP(16, 18) SWAP(20, 22) SWAP(24, 26) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) SWAP(22, 23) SWAP(24, 25) SWAP(26, 27)
+
+// 173 comparators in 15 layers, merged from 14 and 16
+#define NETWORK30(SWAP) \
+	SWAP(0, 1) SWAP(2, 3) SWAP(4, 5) SWAP(6, 7) SWAP(8, 9) SWAP(10, 11) SWAP(12, 13) SWAP(14, 15) SWAP(16, 17) SWAP(18, 19) SWAP(20, 21) SWAP(22, 23) SWAP(24, 25) SWAP(26, 27) SWAP(28, 29) \
+	SWAP(0, 2) SWAP(1, 3) SWAP(4, 8) SWAP(5, 9) SWAP(10, 12) SWAP(11, 13) SWAP(14, 16) SWAP(18, 20) SWAP(22, 24) SWAP(26, 28) SWAP(15, 17) SWAP(19, 21) SWAP(23, 25) SWAP(27, 29) \
+	SWAP(0, 4) SWAP(1, 2) SWAP(3, 7) SWAP(5, 8) SWAP(6, 10) SWAP(9, 13) SWAP(11, 12) SWAP(14, 18) SWAP(22, 26) SWAP(15, 19) SWAP(23, 27) SWAP(16, 20) SWAP(24, 28) SWAP(17, 21) SWAP(25, 29) \
+	SWAP(0, 6) SWAP(1, 5) SWAP(3, 9) SWAP(4, 10) SWAP(7, 13) SWAP(8, 12) SWAP(14, 22) SWAP(15, 23) SWAP(16, 24) SWAP(17, 25) SWAP(18, 26) SWAP(19, 27) SWAP(20, 28) SWAP(21, 29) \
+	SWAP(2, 10) SWAP(3, 11) SWAP(4, 6) SWAP(7, 9) SWAP(19, 24) SWAP(20, 23) SWAP(17, 26) SWAP(27, 28) SWAP(21, 25) SWAP(15, 16) SWAP(18, 22) SWAP(13, 29) \
+	SWAP(1, 3) SWAP(2, 8) SWAP(5, 11) SWAP(6, 7) SWAP(10, 12) SWAP(15, 18) SWAP(21, 27) SWAP(16, 22) SWAP(25, 28) SWAP(19, 20) SWAP(23, 24) \
+	SWAP(1, 4) SWAP(2, 6) SWAP(3, 5) SWAP(7, 11) SWAP(8, 10) SWAP(9, 12) SWAP(16, 18) SWAP(25, 27) SWAP(17, 22) SWAP(21, 26) \
+	SWAP(2, 4) SWAP(3, 6) SWAP(5, 8) SWAP(7, 10) SWAP(9, 11) SWAP(20, 22) SWAP(24, 26) SWAP(17, 19) SWAP(21, 23) SWAP(0, 16) SWAP(12, 28) \
+	SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(17, 18) SWAP(19, 20) SWAP(21, 22) SWAP(23, 24) SWAP(25, 26) SWAP(11, 27) \
+	SWAP(6, 7) SWAP(20, 21) SWAP(22, 23) SWAP(2, 18) SWAP(10, 26) SWAP(8, 24) SWAP(3, 19) SWAP(1, 17) SWAP(9, 25) \
+	SWAP(6, 22) SWAP(10, 18) SWAP(8, 16) SWAP(4, 20) SWAP(7, 23) SWAP(11, 19) SWAP(9, 17) SWAP(5, 21) \
+	SWAP(6, 14) SWAP(18, 22) SWAP(12, 20) SWAP(4, 8) SWAP(7, 15) SWAP(19, 23) SWAP(13, 21) SWAP(5, 9) \
+	SWAP(2, 6) SWAP(10, 14) SWAP(12, 16) SWAP(20, 24) SWAP(3, 7) SWAP(11, 15) SWAP(13, 17) SWAP(21, 25) \
+	SWAP(0, 2) SWAP(4, 6) SWAP(8, 10) SWAP(12, 14) SWAP(16, 18) SWAP(20, 22) SWAP(24, 26) SWAP(1, 3) SWAP(5, 7) SWAP(9, 11) SWAP(13, 15) SWAP(17, 19) SWAP(21, 23) SWAP(25, 27) \
+	SWAP(1, 2) SWAP(3, 4) SWAP(5, 6) SWAP(7, 8) SWAP(9, 10) SWAP(11, 12) SWAP(13, 14) SWAP(15, 16) SWAP(17, 18) SWAP(19, 20) SWAP(21, 22) SWAP(23, 24) SWAP(25, 26) SWAP(27, 28)
+
+#endif
@@ -1,11 +1,24 @@
 #include <string.h>
+#include <stdlib.h>
 #include <pthread.h>
 #include <time.h>
 
 #include "thread_pool.h"
 #include "worker.h"
 
-#define OUTPUT_CACHE 100000
+#define OUTPUT_CACHE_BYTES (1 << 20) // Encoded output collected before it is queued for writing
+
+// Allocates a zeroed array that starts on a cache line.
+// Used for per worker data, so no two workers write to the same line.
+void* thread_pool_alloc_aligned(size_t count, size_t size) {
+	size_t bytes = count * size;
+	bytes = (bytes + THREAD_POOL_CACHE_LINE - 1) / THREAD_POOL_CACHE_LINE * THREAD_POOL_CACHE_LINE;
+	
+	void* retval = aligned_alloc(THREAD_POOL_CACHE_LINE, bytes);
+	memset(retval, 0, bytes);
+	
+	return retval;
+}
 
 ThreadPool* thread_pool_create(int n_threads, int input_length, int output_length) {
 	ThreadPool* retval = calloc(1, sizeof(ThreadPool));
@@ -23,8 +36,9 @@ ThreadPool* thread_pool_create(int n_threads, int input_length, int output_lengt
 	
 	pthread_mutex_init(&retval->input_lock, NULL);
 	pthread_mutex_init(&retval->output_lock, NULL);
-	pthread_mutex_init(&retval->write_lock, NULL);
-	pthread_mutex_init(&retval->progress_lock, NULL);
+	pthread_mutex_init(&retval->ring_lock, NULL);
+	pthread_cond_init(&retval->ring_not_empty, NULL);
+	pthread_cond_init(&retval->ring_not_full, NULL);
 	
 	printf("Using thread pool with %d threads to generate n=%d from n=%d\n", 
 		n_threads, output_length, input_length);
@@ -34,28 +48,50 @@ ThreadPool* thread_pool_create(int n_threads, int input_length, int output_lengt
 
 void thread_pool_destroy(ThreadPool* pool) {
 	if (pool->mode == OutputWriter) {
-		free(pool->output_keys);
-		free(pool->write_keys);
+		for (int i = 0; i < THREAD_POOL_RING_SIZE; i++) {
+			free(pool->ring[i]);
+		}
+		
 		free(pool->results);
 	}
 	
 	if (pool->reader != NULL) {
-		free(pool->input_keys);
+		key_list_destroy(pool->input_keys);
+	}
+	
+	if (pool->ranges != NULL) {
+		for (int i = 0; i < pool->n_threads; i++) {
+			pthread_mutex_destroy(&pool->ranges[i].lock);
+		}
+		
+		free(pool->ranges);
 	}
 
 	free(pool);
 }
 
-void thread_pool_set_input_keys(ThreadPool* pool, Key* input_keys, uint64_t input_count) {
+// With all input keys in memory, each worker starts with an equal share of them
+void thread_pool_set_input_keys(ThreadPool* pool, KeyList* input_keys) {
 	pool->input_keys = input_keys;
-	pool->input_count = input_count;
-	pool->total_input_count = input_count;
+	pool->input_count = input_keys->count;
+	pool->total_input_count = input_keys->count;
+	
+	pool->ranges = thread_pool_alloc_aligned(pool->n_threads, sizeof(SeedRange));
+	
+	for (int i = 0; i < pool->n_threads; i++) {
+		SeedRange* range = &pool->ranges[i];
+		
+		range->begin = input_keys->count * i / pool->n_threads;
+		range->end = input_keys->count * (i + 1) / pool->n_threads;
+		range->random_state = i + 1;
+		pthread_mutex_init(&range->lock, NULL);
+	}
 }
 
 void thread_pool_set_input_reader(ThreadPool* pool, Reader* reader) {
 	pool->reader = reader;
 	pool->input_count = 0;
-	pool->input_keys = calloc(READER_MAX_COUNT, sizeof(Key));
+	pool->input_keys = key_list_create(reader_get_n(reader), READER_MAX_COUNT);
 	
 	uint64_t count = reader_get_count(reader);
 	if (count > 0) {
@@ -68,7 +104,7 @@ void thread_pool_set_input_reader(ThreadPool* pool, Reader* reader) {
 	}
 }
 
-void thread_pool_set_output_keys(ThreadPool* pool, Key* output_keys) {
+void thread_pool_set_output_keys(ThreadPool* pool, KeyList* output_keys) {
 	pool->mode = OutputKeys;
 	pool->output_keys = output_keys;
 }
@@ -77,52 +113,129 @@ void thread_pool_set_output_writer(ThreadPool* pool, Writer* writer) {
 	pool->mode = OutputWriter;
 	pool->writer = writer;
 	
-	pool->output_keys = calloc(OUTPUT_CACHE + 1000, sizeof(Key));
-	pool->write_keys = calloc(OUTPUT_CACHE + 1000, sizeof(Key));
+	// Room for one more worker batch once the cache size is reached
+	size_t capacity = OUTPUT_CACHE_BYTES + WORKER_BATCH_SIZE * writer_max_key_size(writer);
+	
+	for (int i = 0; i < THREAD_POOL_RING_SIZE; i++) {
+		pool->ring[i] = calloc(capacity, sizeof(uint8_t));
+	}
+	
+	pool->output_bytes = pool->ring[0];
+	pool->output_size = 0;
+}
+
+// Prints the progress bar for the given input index
+void thread_pool_print_progress(ThreadPool* pool, uint64_t input_index, time_t now) {
+	double diff = difftime(now, pool->start_time);
+	
+	double est_total = diff * pool->total_input_count / input_index;
+	int percent = (int)(100 * input_index / pool->total_input_count);
+	
+	int bars = percent / 5;
 	
-	pool->output_index = 0;
+	char progress[21];
+	progress[20] = 0;
+	
+	for (int i = 0; i < 20; i++) {
+		if (bars > i) progress[i] = '=';
+		else progress[i] = ' ';
+	}
+	
+	printf("  [%s] %d%% (est. %.f seconds remaining)    \r", 
+		progress, percent, est_total - diff);
+	fflush(stdout);
 }
 
-void thread_pool_update_progress(ThreadPool* pool) {
+// Counts fetched seeds and prints the progress bar at most once a second.
+// No lock is taken: the worker that moves the last update time forward prints the update.
+void thread_pool_add_progress(ThreadPool* pool, int count) {
+	uint64_t input_index = __atomic_add_fetch(&pool->total_input_index, count, __ATOMIC_RELAXED);
+	
+	if (!pool->do_updates) return;
+	
 	time_t now = time(NULL);
+	time_t last = __atomic_load_n(&pool->last_update_time, __ATOMIC_RELAXED);
+	
+	if (difftime(now, last) < 1) return;
+	if (!__atomic_compare_exchange_n(&pool->last_update_time, &last, now, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) return;
 	
-	double since_last = difftime(now, pool->last_update_time);
+	thread_pool_print_progress(pool, input_index, now);
+}
 
-	if (since_last >= 1) {
-		
-		double diff = difftime(now, pool->start_time);
-		
-		pthread_mutex_lock(&pool->progress_lock);
-		double est_total = diff * pool->total_input_count / pool->total_input_index;
-		int percent = (int)(100 * pool->total_input_index / pool->total_input_count);
-		pthread_mutex_unlock(&pool->progress_lock);
+int thread_pool_get_fetch_count(ThreadPool* pool) {
+	uint64_t new_index = pool->input_index + WORKER_FETCH_COUNT;
+	new_index = new_index >= pool->input_count ? pool->input_count : new_index;
+	int count = new_index - pool->input_index;
+	
+	return count;
+}
+
+// Moves the back half of another worker's range into this worker's empty range.
+// Workers are tried in turn from a random one.
+// Returns 0 if every other range was empty.
+int thread_pool_steal_range(ThreadPool* pool, int worker_index) {
+	SeedRange* own = &pool->ranges[worker_index];
+	int start = rand_r(&own->random_state) % pool->n_threads;
+	
+	for (int i = 0; i < pool->n_threads; i++) {
+		int victim_index = (start + i) % pool->n_threads;
+		if (victim_index == worker_index) continue;
 		
-		int bars = percent / 5;
+		SeedRange* victim = &pool->ranges[victim_index];
 		
-		char progress[21];
-		progress[20] = 0;
+		pthread_mutex_lock(&victim->lock);
+		uint64_t end = victim->end;
+		uint64_t take = (end - victim->begin + 1) / 2;
+		victim->end -= take;
+		pthread_mutex_unlock(&victim->lock);
 		
-		for (int i = 0; i < 20; i++) {
-			if (bars > i) progress[i] = '=';
-			else progress[i] = ' ';
+		if (take == 0) {
+			own->steal_misses++;
+			continue;
 		}
 		
-		printf("  [%s] %d%% (est. %.f seconds remaining)    \r", 
-			progress, percent, est_total - diff);
-		fflush(stdout);
-		pool->last_update_time = now;
+		pthread_mutex_lock(&own->lock);
+		own->begin = end - take;
+		own->end = end;
+		pthread_mutex_unlock(&own->lock);
+		
+		own->steals++;
+		return 1;
 	}
+	
+	return 0;
 }
 
-int thread_pool_get_fetch_count(ThreadPool* pool) {
-	uint64_t new_index = pool->input_index + WORKER_FETCH_COUNT;
-	new_index = new_index >= pool->input_count ? pool->input_count : new_index;
-	int count = new_index - pool->input_index;
+// Takes the next seeds from the front of the worker's own range, stealing when it is empty.
+// Seeds only move between ranges, so once no range has any left, the input is done.
+int thread_pool_fetch_range(ThreadPool* pool, int worker_index, KeyList* fetched_keys) {
+	SeedRange* own = &pool->ranges[worker_index];
+	uint64_t begin;
+	int count;
+	
+	while (1) {
+		pthread_mutex_lock(&own->lock);
+		begin = own->begin;
+		count = own->end - begin < WORKER_FETCH_COUNT ? own->end - begin : WORKER_FETCH_COUNT;
+		own->begin += count;
+		pthread_mutex_unlock(&own->lock);
+		
+		if (count > 0 || !thread_pool_steal_range(pool, worker_index)) break;
+	}
+	
+	key_list_copy(fetched_keys, 0, pool->input_keys, begin, count);
+	fetched_keys->count = count;
+	
+	thread_pool_add_progress(pool, count);
 	
 	return count;
 }
 
-int thread_pool_fetch_seeds(ThreadPool* pool, Key* fetched_keys) {
+// Fetches the next seeds for a worker. In-memory input is split into per worker ranges,
+// while input from a reader is handed out from a single shared buffer.
+int thread_pool_fetch_seeds(ThreadPool* pool, int worker_index, KeyList* fetched_keys) {
+	if (pool->ranges != NULL) return thread_pool_fetch_range(pool, worker_index, fetched_keys);
+	
 	pthread_mutex_lock(&pool->input_lock);	
 		
 	int count = thread_pool_get_fetch_count(pool);
@@ -132,13 +245,12 @@ int thread_pool_fetch_seeds(ThreadPool* pool, Key* fetched_keys) {
 		count = thread_pool_get_fetch_count(pool);
 	}
 	
-	memcpy(fetched_keys, &pool->input_keys[pool->input_index], count * sizeof(Key));
+	key_list_copy(fetched_keys, 0, pool->input_keys, pool->input_index, count);
+	fetched_keys->count = count;
 	
 	pool->input_index += count;
 	
-	pthread_mutex_lock(&pool->progress_lock);
-	pool->total_input_index += count;
-	pthread_mutex_unlock(&pool->progress_lock);
+	thread_pool_add_progress(pool, count);
 		
 	pthread_mutex_unlock(&pool->input_lock);
 	
@@ -154,14 +266,64 @@ uint64_t thread_pool_read(ThreadPool* pool) {
 	return n_read;
 }
 
-void thread_pool_write(ThreadPool* pool, uint64_t write_count) {
-	writer_write_keys(pool->writer, pool->write_keys, write_count);
+// Hands the buffer being filled to the writer thread and moves on to the next one.
+// Waits for the writer only if every buffer is full.
+// Must be called with the output lock held.
+void thread_pool_queue_output(ThreadPool* pool) {
+	pthread_mutex_lock(&pool->ring_lock);
+	
+	int fill = (pool->ring_start + pool->ring_filled) % THREAD_POOL_RING_SIZE;
+	pool->ring_sizes[fill] = pool->output_size;
+	pool->ring_filled++;
+	pthread_cond_signal(&pool->ring_not_empty);
+	
+	if (pool->ring_filled == THREAD_POOL_RING_SIZE) pool->writer_waits++;
+	
+	while (pool->ring_filled == THREAD_POOL_RING_SIZE) {
+		pthread_cond_wait(&pool->ring_not_full, &pool->ring_lock);
+	}
+	
+	fill = (pool->ring_start + pool->ring_filled) % THREAD_POOL_RING_SIZE;
+	
+	pthread_mutex_unlock(&pool->ring_lock);
+	
+	pool->output_bytes = pool->ring[fill];
+	pool->output_size = 0;
 }
 
-void thread_pool_swap_write_keys(ThreadPool* pool) {
-	Key* temp = pool->write_keys;
-	pool->write_keys = pool->output_keys;
-	pool->output_keys = temp;
+// Writes the full buffers in the order they were queued, until the workers are done
+void* thread_pool_writer_function(void* arg) {
+	ThreadPool* pool = (ThreadPool*) arg;
+	
+	while (1) {
+		pthread_mutex_lock(&pool->ring_lock);
+		
+		while (pool->ring_filled == 0 && !pool->ring_done) {
+			pthread_cond_wait(&pool->ring_not_empty, &pool->ring_lock);
+		}
+		
+		if (pool->ring_filled == 0) {
+			pthread_mutex_unlock(&pool->ring_lock);
+			break;
+		}
+		
+		int start = pool->ring_start;
+		
+		pthread_mutex_unlock(&pool->ring_lock);
+		
+		// The buffer stays counted as full while it is written, so no worker fills it
+		writer_write_bytes(pool->writer, pool->ring[start], pool->ring_sizes[start]);
+		
+		pthread_mutex_lock(&pool->ring_lock);
+		
+		pool->ring_start = (start + 1) % THREAD_POOL_RING_SIZE;
+		pool->ring_filled--;
+		pthread_cond_signal(&pool->ring_not_full);
+		
+		pthread_mutex_unlock(&pool->ring_lock);
+	}
+	
+	pthread_exit(NULL);
 }
 
 void thread_pool_enable_updates(ThreadPool* pool) {
@@ -173,10 +335,7 @@ void thread_pool_enable_updates(ThreadPool* pool) {
 	fflush(stdout);
 }
 
-void thread_pool_push_output(ThreadPool* pool, Key* output_keys, int output_count) {
-	int do_write = 0;
-	uint64_t write_count = 0;
-	
+void thread_pool_push_output(ThreadPool* pool, KeyList* output_keys, int output_count) {
 	if (output_count == 0) return;
 	
 	pthread_mutex_lock(&pool->output_lock);
@@ -186,72 +345,106 @@ void thread_pool_push_output(ThreadPool* pool, Key* output_keys, int output_coun
 			pool->output_count += output_count;
 			break;
 		case OutputKeys:
-			memcpy(&pool->output_keys[pool->output_count], output_keys, output_count * sizeof(Key));
+			key_list_reserve(pool->output_keys, pool->output_count + output_count);
+			key_list_copy(pool->output_keys, pool->output_count, output_keys, 0, output_count);
 			pool->output_count += output_count;
+			pool->output_keys->count = pool->output_count;
 			break;
-		case OutputWriter:
-			memcpy(&pool->output_keys[pool->output_index], output_keys, output_count * sizeof(Key));
-			pool->output_count += output_count;
-			pool->output_index += output_count;
-			
-			if (pool->output_index > OUTPUT_CACHE) {
-				do_write = 1;
-				
-				pthread_mutex_lock(&pool->write_lock);
-				
-				thread_pool_swap_write_keys(pool);
-				
-				write_count = pool->output_index;
-				
-				pool->output_index = 0;
-				
-			}
 		default:
 			break;
 	}
 	
-	if (pool->do_updates) {
-		thread_pool_update_progress(pool);
-	}
-	
 	pthread_mutex_unlock(&pool->output_lock);
+}
+
+// Adds keys the worker has already encoded for the writer
+void thread_pool_push_bytes(ThreadPool* pool, uint8_t* bytes, size_t size, int output_count) {
+	if (output_count == 0) return;
 	
-	if (do_write) {
-		thread_pool_write(pool, write_count);
-		
-		pthread_mutex_unlock(&pool->write_lock);
-	}
+	pthread_mutex_lock(&pool->output_lock);
+	
+	memcpy(&pool->output_bytes[pool->output_size], bytes, size);
+	pool->output_size += size;
+	pool->output_count += output_count;
+	
+	if (pool->output_size >= OUTPUT_CACHE_BYTES) thread_pool_queue_output(pool);
+	
+	pthread_mutex_unlock(&pool->output_lock);
 }
 
 uint64_t thread_pool_get_total(ThreadPool* pool, int index) {	
 	return pool->results[index];
 }
 
+// Counts a worker as busy again after stealing seeds, or as idle once it has none
+void thread_pool_set_busy(ThreadPool* pool, int busy) {
+	__atomic_add_fetch(&pool->busy_workers, busy ? 1 : -1, __ATOMIC_SEQ_CST);
+}
+
+int thread_pool_get_busy(ThreadPool* pool) {
+	return __atomic_load_n(&pool->busy_workers, __ATOMIC_SEQ_CST);
+}
+
 uint64_t thread_pool_run(ThreadPool* pool) {
 	pthread_t threads[pool->n_threads];
 	WorkerData* worker_data[pool->n_threads];
 	
+	// Every worker exists before any starts, since idle workers look at all of them
 	for (int i = 0; i < pool->n_threads; i++) {
-		worker_data[i] = worker_create(pool, pool->input_length, pool->output_length);
+		worker_data[i] = worker_create(pool, i, pool->input_length, pool->output_length);
+	}
+	
+	pool->workers = worker_data;
+	pool->busy_workers = pool->n_threads;
+	
+	if (pool->mode == OutputWriter) {
+		pthread_create(&pool->writer_thread, NULL, thread_pool_writer_function, pool);
+	}
 	
+	for (int i = 0; i < pool->n_threads; i++) {
 		pthread_create(&threads[i], NULL, worker_thread_function, worker_data[i]);
 	}
 	
 	for (int i = 0; i < pool->n_threads; i++) {
 		pthread_join(threads[i], NULL);
-		
+	}
+	
+	for (int i = 0; i < pool->n_threads; i++) {
 		int count = pool->output_length - pool->input_length;
 		
 		for (int j = 0; j < count; j++) {
 			pool->results[j] += worker_get_total(worker_data[i], j);
 		}
 		
+		generator_stats_add(&pool->stats, &worker_data[i]->stats);
+		pool->level_steals += worker_data[i]->level_steals;
+		pool->idle_waits += worker_data[i]->idle_waits;
+		
+		if (pool->ranges != NULL) {
+			pool->steals += pool->ranges[i].steals;
+			pool->steal_misses += pool->ranges[i].steal_misses;
+		}
+		
 		worker_destroy(worker_data[i]);
 	}
 	
+	pool->workers = NULL;
+	
+	// Counting workers never push their output, so the count is the last level's total
+	if (pool->mode == OutputCount) {
+		pool->output_count = pool->results[pool->output_length - pool->input_length - 1];
+	}
+	
+	// Queue the last buffer, then wait for the writer to finish the ring
 	if (pool->mode == OutputWriter) {
-		thread_pool_swap_write_keys(pool);
-		thread_pool_write(pool, pool->output_index);
+		if (pool->output_size > 0) thread_pool_queue_output(pool);
+		
+		pthread_mutex_lock(&pool->ring_lock);
+		pool->ring_done = 1;
+		pthread_cond_signal(&pool->ring_not_empty);
+		pthread_mutex_unlock(&pool->ring_lock);
+		
+		pthread_join(pool->writer_thread, NULL);
 	}
 	
 	return pool->output_count;
@@ -3,22 +3,44 @@
 #include <stdio.h>
 
 #include "key.h"
+#include "key_list.h"
 #include "reader.h"
 #include "writer.h"
+#include "generator.h"
 
 #ifndef THREAD_POOL_H
 #define THREAD_POOL_H
 
+#define THREAD_POOL_CACHE_LINE 64
+#define THREAD_POOL_RING_SIZE 4 // Output buffers shared by the workers and the writer thread
+
 typedef enum {OutputWriter, OutputKeys, OutputCount} OutputMode;
 
+struct WorkerData;
+
+// A worker's share of the input keys. Workers take seeds from the front of their own range,
+// and take the back half of another worker's range when theirs runs out.
+// Each range has its own cache line, so workers taking seeds don't slow each other down.
+typedef struct __attribute__((aligned(THREAD_POOL_CACHE_LINE))) {
+	uint64_t begin;
+	uint64_t end;
+	unsigned int random_state; // Picks the first worker to steal from
+	uint64_t steals; // Ranges taken from other workers
+	uint64_t steal_misses; // Workers found empty while looking for a range
+	pthread_mutex_t lock;
+} SeedRange;
+
 typedef struct {
 	int n_threads;
+	struct WorkerData** workers; // Set while running, so idle workers can steal from busy ones
+	int busy_workers; // Workers that have seeds, changed atomically
 	
 	// Input data
 	int input_length; // Input key length
-	Key* input_keys;
+	KeyList* input_keys;
 	uint64_t input_count; // Count of keys in the input buffer
 	uint64_t input_index; // Index of keys in the input buffer
+	SeedRange* ranges; // Per worker ranges of the input buffer, NULL when fed by a reader
 	
 	// File I/O
 	Reader* reader;
@@ -26,43 +48,66 @@ typedef struct {
 	
 	// Output data
 	int output_length; // Output key length
-	Key* output_keys; // Primary buffer
-	Key* write_keys;  // Secondary buffer (count stored locally during write)
+	KeyList* output_keys; // Output keys, when they are kept in memory
 	uint64_t output_count; // Count in primary buffer
-	uint64_t output_index; // Index of primary buffer
+	uint8_t* output_bytes; // Encoded keys being filled, one of the ring buffers when writing
+	size_t output_size; // Bytes in the buffer being filled
+	
+	// Writer ring. Full buffers wait in the ring from ring_start until the writer thread
+	// has written them, and the buffer after the last full one is the one being filled.
+	// Workers only wait for the writer when every buffer is full.
+	uint8_t* ring[THREAD_POOL_RING_SIZE];
+	size_t ring_sizes[THREAD_POOL_RING_SIZE]; // Bytes in each full buffer
+	int ring_start; // First full buffer
+	int ring_filled; // Number of full buffers
+	int ring_done; // No more buffers will be filled
+	pthread_t writer_thread;
+	uint64_t writer_waits; // Times a full buffer had to wait for a free one
 	OutputMode mode;
 	uint64_t* results;
+	GeneratorStats stats; // Summed from the workers when they finish
+	uint64_t steals; // Summed from the seed ranges when the workers finish
+	uint64_t steal_misses;
+	uint64_t level_steals; // Summed from the workers when they finish
+	uint64_t idle_waits;
 	
 	// Progress updates
 	int do_updates;
-	uint64_t total_input_index; // Total input index for progress updates
+	uint64_t total_input_index; // Total input index for progress updates, changed atomically
 	uint64_t total_input_count; // Total input count for progress updates
 	time_t start_time;
-	time_t last_update_time;
+	time_t last_update_time; // Changed atomically by the worker that prints the update
 	
 	// Locks
 	pthread_mutex_t input_lock;
 	pthread_mutex_t output_lock;
-	pthread_mutex_t write_lock;
-	pthread_mutex_t progress_lock;
+	pthread_mutex_t ring_lock;
+	pthread_cond_t ring_not_empty;
+	pthread_cond_t ring_not_full;
 } ThreadPool;
 
+void* thread_pool_alloc_aligned(size_t count, size_t size);
+
 ThreadPool* thread_pool_create(int n_threads, int input_length, int output_length);
 void thread_pool_destroy(ThreadPool* pool);
 
-void thread_pool_set_input_keys(ThreadPool* pool, Key* input_keys, uint64_t input_count);
+void thread_pool_set_input_keys(ThreadPool* pool, KeyList* input_keys);
 void thread_pool_set_input_reader(ThreadPool* pool, Reader* reader);
 
-void thread_pool_set_output_keys(ThreadPool* pool, Key* output_keys);
+void thread_pool_set_output_keys(ThreadPool* pool, KeyList* output_keys);
 void thread_pool_set_output_writer(ThreadPool* pool, Writer* writer);
 
 uint64_t thread_pool_read(ThreadPool* pool);
-int thread_pool_fetch_seeds(ThreadPool* pool, Key* fetch_keys);
-void thread_pool_push_output(ThreadPool* pool, Key* output_keys, int output_count);
+int thread_pool_fetch_seeds(ThreadPool* pool, int worker_index, KeyList* fetch_keys);
+void thread_pool_push_output(ThreadPool* pool, KeyList* output_keys, int output_count);
+void thread_pool_push_bytes(ThreadPool* pool, uint8_t* bytes, size_t size, int output_count);
 
 void thread_pool_enable_updates(ThreadPool* pool);
 uint64_t thread_pool_get_total(ThreadPool* pool, int index);
 
+void thread_pool_set_busy(ThreadPool* pool, int busy);
+int thread_pool_get_busy(ThreadPool* pool);
+
 uint64_t thread_pool_run(ThreadPool* pool);
 
 #endif
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "generator.h"
+#include "worker.h"
+#include "key_list.h"
+#include "point.h"
+
+// Times generation and filtering of every polycube of length n
+// from the full set of length n-1 seeds on a single thread.
+// Usage: generator_bench [n] [rounds]
+
+double get_time_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Expands every seed of a list by one point
+KeyList* expand_all(KeyList* seeds, KeyList* scratch, uint8_t* spacemap) {
+	KeyList* retval = key_list_create(seeds->length + 1, seeds->count);
+	GeneratorStats stats = {0};
+	RotationSet sets[GENERATOR_NUM_SETS];
+	
+	for (uint64_t i = 0; i < seeds->count; i++) {
+		Key seed = key_list_get(seeds, i);
+		Point dimensions = key_list_get_dimensions(seeds, i);
+		generator_reset_rotation_sets(sets);
+		generator_generate(&seed, dimensions, retval->length, scratch, spacemap, sets, &stats);
+		int count = worker_filter_keys(scratch, spacemap);
+		
+		key_list_reserve(retval, retval->count + count);
+		key_list_copy(retval, retval->count, scratch, 0, count);
+		retval->count += count;
+	}
+	
+	return retval;
+}
+
+int main(int argc, char** argv) {
+	int n = argc > 1 ? atoi(argv[1]) : 11;
+	int rounds = argc > 2 ? atoi(argv[2]) : 3;
+	
+	if (n < 4 || n > 13) {
+		printf("Length must be between 4 and 13\n");
+		return 1;
+	}
+	
+	uint8_t* spacemap = calloc(POINT_SPACEMAP_SIZE, sizeof(uint8_t));
+	
+	Key start;
+	start.data[0] = point_from_coords(1, 1, 1);
+	start.data[1] = point_get_offset(start.data[0], 0);
+	start.length = 2;
+	start.source_index = 0;
+	
+	KeyList* seeds = key_list_create(2, 1);
+	key_list_push(seeds, &start);
+	
+	// Build the seeds level by level, each list growing as it fills
+	while (seeds->length < n - 1) {
+		KeyList* scratch = key_list_create(seeds->length + 1, WORKER_OUTPUT_SIZE);
+		KeyList* next = expand_all(seeds, scratch, spacemap);
+		key_list_destroy(scratch);
+		key_list_destroy(seeds);
+		seeds = next;
+	}
+	
+	printf("Generating n=%d from %lld seeds\n", n, (long long int) seeds->count);
+	
+	KeyList* scratch = key_list_create(n, WORKER_OUTPUT_SIZE);
+	double best_generate = 1e30;
+	double best_total = 1e30;
+	uint64_t generated = 0;
+	uint64_t kept = 0;
+	GeneratorStats stats; // counted over the generate pass only
+	GeneratorStats total_stats;
+	RotationSet sets[GENERATOR_NUM_SETS];
+	
+	for (int r = 0; r < rounds; r++) {
+		generated = 0;
+		kept = 0;
+		stats = (GeneratorStats) {0};
+		total_stats = (GeneratorStats) {0};
+		
+		double start_time = get_time_ns();
+		for (uint64_t i = 0; i < seeds->count; i++) {
+			Key seed = key_list_get(seeds, i);
+			Point dimensions = key_list_get_dimensions(seeds, i);
+			generator_reset_rotation_sets(sets);
+			generated += generator_generate(&seed, dimensions, n, scratch, spacemap, sets, &stats);
+		}
+		double generate_time = get_time_ns() - start_time;
+		
+		start_time = get_time_ns();
+		for (uint64_t i = 0; i < seeds->count; i++) {
+			Key seed = key_list_get(seeds, i);
+			Point dimensions = key_list_get_dimensions(seeds, i);
+			generator_reset_rotation_sets(sets);
+			generator_generate(&seed, dimensions, n, scratch, spacemap, sets, &total_stats);
+			kept += worker_filter_keys(scratch, spacemap);
+		}
+		double total_time = get_time_ns() - start_time;
+		
+		if (generate_time < best_generate) best_generate = generate_time;
+		if (total_time < best_total) best_total = total_time;
+	}
+	
+	generator_stats_print(&stats);
+	printf("%lld keys generated, %lld polycubes kept\n", (long long int) generated, (long long int) kept);
+	printf("generate:          %8.1f ns per seed\n", best_generate / seeds->count);
+	printf("generate + filter: %8.1f ns per seed\n", best_total / seeds->count);
+	
+	key_list_destroy(scratch);
+	key_list_destroy(seeds);
+	free(spacemap);
+	
+	return 0;
+}
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "network_sort.h"
+#include "network_sort_avx2.h"
+
+// Times every sorting network against qsort on random points.
+// Usage: network_bench [rounds]
+
+#define MAX_LENGTH 32
+#define ARRAY_COUNT 4096
+
+#define NETWORK_ENTRY(n) [n] = network_sort##n,
+static void (*const network_functions[MAX_LENGTH + 1])(uint16_t*) = {
+	SORTING_NETWORKS(NETWORK_ENTRY)
+};
+
+int compare_uint16(const void* a, const void* b) {
+	return *(const uint16_t*) a - *(const uint16_t*) b;
+}
+
+double get_time_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char** argv) {
+	int rounds = argc > 1 ? atoi(argv[1]) : 5;
+	
+	uint16_t (*source)[MAX_LENGTH] = calloc(ARRAY_COUNT, sizeof(*source));
+	uint16_t (*work)[MAX_LENGTH] = calloc(ARRAY_COUNT, sizeof(*work));
+	
+	srand(1);
+	for (int i = 0; i < ARRAY_COUNT; i++) {
+		for (int j = 0; j < MAX_LENGTH; j++) source[i][j] = rand() & 0x7FFF;
+	}
+	
+	printf("length    qsort  network     avx2 (ns per sort, best of %d)\n", rounds);
+	
+	for (int length = 2; length <= MAX_LENGTH; length++) {
+		if (!network_functions[length]) continue;
+		
+		double best[3] = {1e30, 1e30, 1e30};
+		int has_avx2 = 0;
+		
+		for (int r = 0; r < rounds; r++) {
+			memcpy(work, source, ARRAY_COUNT * sizeof(*work));
+			double start = get_time_ns();
+			for (int i = 0; i < ARRAY_COUNT; i++) qsort(work[i], length, sizeof(uint16_t), compare_uint16);
+			double t = get_time_ns() - start;
+			if (t < best[0]) best[0] = t;
+			
+			memcpy(work, source, ARRAY_COUNT * sizeof(*work));
+			start = get_time_ns();
+			for (int i = 0; i < ARRAY_COUNT; i++) network_functions[length](work[i]);
+			t = get_time_ns() - start;
+			if (t < best[1]) best[1] = t;
+			
+#ifdef CPU_X86_SIMD
+			if (cpu_has_avx2()) {
+				memcpy(work, source, ARRAY_COUNT * sizeof(*work));
+				start = get_time_ns();
+				for (int i = 0; i < ARRAY_COUNT; i++) network_sort_avx2(work[i], length);
+				t = get_time_ns() - start;
+				if (t < best[2]) best[2] = t;
+				has_avx2 = 1;
+			}
+#endif
+		}
+		
+		// Every network must agree with qsort
+		for (int i = 0; i < ARRAY_COUNT; i++) {
+			uint16_t expected[MAX_LENGTH];
+			memcpy(expected, source[i], sizeof(expected));
+			qsort(expected, length, sizeof(uint16_t), compare_uint16);
+			
+			memcpy(work[i], source[i], sizeof(expected));
+			network_functions[length](work[i]);
+			if (memcmp(expected, work[i], length * sizeof(uint16_t))) {
+				printf("Network for length %d does not sort\n", length);
+				return 1;
+			}
+			
+#ifdef CPU_X86_SIMD
+			if (has_avx2) {
+				memcpy(work[i], source[i], sizeof(expected));
+				network_sort_avx2(work[i], length);
+				if (memcmp(expected, work[i], length * sizeof(uint16_t))) {
+					printf("AVX2 network for length %d does not sort\n", length);
+					return 1;
+				}
+			}
+#endif
+		}
+		
+		printf("%6d %8.1f %8.1f ", length, best[0] / ARRAY_COUNT, best[1] / ARRAY_COUNT);
+		if (has_avx2) printf("%8.1f\n", best[2] / ARRAY_COUNT);
+		else printf("%8s\n", "-");
+	}
+	
+	free(source);
+	free(work);
+	
+	return 0;
+}
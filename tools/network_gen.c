@@ -0,0 +1,502 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// Generates sorting_networks.h with a sorting network for every key length.
+// Known networks are stored below and checked with the 0-1 principle.
+// Every other length is derived from them, and the smallest network is kept:
+// - Pruning a longer network, by fixing its lowest and highest inputs
+//   to values that never move, which makes every comparator on them a no-op
+// - Sorting two parts separately and joining them with Batcher's odd-even merge
+// Usage: network_gen > sorting_networks.h
+
+#define MIN_LENGTH 2
+#define MAX_LENGTH 30
+#define MAX_PAIRS 1024
+
+typedef struct {
+	int count;
+	uint8_t pairs[MAX_PAIRS][2];
+	char source[64];
+} Network;
+
+// Optimal networks for up to 10 inputs
+// https://bertdobbelaere.github.io/sorting_networks.html
+static const uint8_t network2[][2] = {
+	{0, 1}
+};
+
+static const uint8_t network3[][2] = {
+	{0, 2}, {0, 1}, {1, 2}
+};
+
+static const uint8_t network4[][2] = {
+	{0, 2}, {1, 3}, {0, 1}, {2, 3}, {1, 2}
+};
+
+static const uint8_t network5[][2] = {
+	{0, 3}, {1, 4}, {0, 2}, {1, 3}, {0, 1}, {2, 4}, {1, 2}, {3, 4},
+	{2, 3}
+};
+
+static const uint8_t network6[][2] = {
+	{0, 5}, {1, 3}, {2, 4}, {1, 2}, {3, 4}, {0, 3}, {2, 5}, {0, 1},
+	{2, 3}, {4, 5}, {1, 2}, {3, 4}
+};
+
+static const uint8_t network7[][2] = {
+	{0, 6}, {2, 3}, {4, 5}, {0, 2}, {1, 4}, {3, 6}, {0, 1}, {2, 5},
+	{3, 4}, {1, 2}, {4, 6}, {2, 3}, {4, 5}, {1, 2}, {3, 4}, {5, 6}
+};
+
+static const uint8_t network8[][2] = {
+	{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7},
+	{0, 1}, {2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6},
+	{1, 2}, {3, 4}, {5, 6}
+};
+
+static const uint8_t network9[][2] = {
+	{0, 3}, {1, 7}, {2, 5}, {4, 8}, {0, 7}, {2, 4}, {3, 8}, {5, 6},
+	{0, 2}, {1, 3}, {4, 5}, {7, 8}, {1, 4}, {3, 6}, {5, 7}, {0, 1},
+	{2, 4}, {3, 5}, {6, 8}, {2, 3}, {4, 5}, {6, 7}, {1, 2}, {3, 4},
+	{5, 6}
+};
+
+static const uint8_t network10[][2] = {
+	{0, 8}, {1, 9}, {2, 7}, {3, 5}, {4, 6}, {0, 2}, {1, 4}, {5, 8},
+	{7, 9}, {0, 3}, {2, 4}, {5, 7}, {6, 9}, {0, 1}, {3, 6}, {8, 9},
+	{1, 5}, {2, 3}, {4, 8}, {6, 7}, {1, 2}, {3, 5}, {4, 6}, {7, 8},
+	{2, 3}, {4, 5}, {6, 7}, {3, 4}, {5, 6}
+};
+
+// Best known networks for 11 to 14 inputs, from the same list.
+// Pruning the 16 input network already gives 15 inputs in as few comparators and layers.
+static const uint8_t network11[][2] = {
+	{0, 9}, {1, 6}, {2, 4}, {3, 7}, {5, 8}, {0, 1}, {3, 5}, {4, 10},
+	{6, 9}, {7, 8}, {1, 3}, {2, 5}, {4, 7}, {8, 10}, {0, 4}, {1, 2},
+	{3, 7}, {5, 9}, {6, 8}, {0, 1}, {2, 6}, {4, 5}, {7, 8}, {9, 10},
+	{2, 4}, {3, 6}, {5, 7}, {8, 9}, {1, 2}, {3, 4}, {5, 6}, {7, 8},
+	{2, 3}, {4, 5}, {6, 7}
+};
+
+static const uint8_t network12[][2] = {
+	{0, 8}, {1, 7}, {2, 6}, {3, 11}, {4, 10}, {5, 9}, {0, 1}, {2, 5},
+	{3, 4}, {6, 9}, {7, 8}, {10, 11}, {0, 2}, {1, 6}, {5, 10}, {9, 11},
+	{0, 3}, {1, 2}, {4, 6}, {5, 7}, {8, 11}, {9, 10}, {1, 4}, {3, 5},
+	{6, 8}, {7, 10}, {1, 3}, {2, 5}, {6, 9}, {8, 10}, {2, 3}, {4, 5},
+	{6, 7}, {8, 9}, {4, 6}, {5, 7}, {3, 4}, {5, 6}, {7, 8}
+};
+
+static const uint8_t network13[][2] = {
+	{0, 12}, {1, 10}, {2, 9}, {3, 7}, {5, 11}, {6, 8}, {1, 6}, {2, 3},
+	{4, 11}, {7, 9}, {8, 10}, {0, 4}, {1, 2}, {3, 6}, {7, 8}, {9, 10},
+	{11, 12}, {4, 6}, {5, 9}, {8, 11}, {10, 12}, {0, 5}, {3, 8}, {4, 7},
+	{6, 11}, {9, 10}, {0, 1}, {2, 5}, {6, 9}, {7, 8}, {10, 11}, {1, 3},
+	{2, 4}, {5, 6}, {9, 10}, {1, 2}, {3, 4}, {5, 7}, {6, 8}, {2, 3},
+	{4, 5}, {6, 7}, {8, 9}, {3, 4}, {5, 6}
+};
+
+static const uint8_t network14[][2] = {
+	{0, 1}, {2, 3}, {4, 5}, {6, 7}, {8, 9}, {10, 11}, {12, 13}, {0, 2},
+	{1, 3}, {4, 8}, {5, 9}, {10, 12}, {11, 13}, {0, 4}, {1, 2}, {3, 7},
+	{5, 8}, {6, 10}, {9, 13}, {11, 12}, {0, 6}, {1, 5}, {3, 9}, {4, 10},
+	{7, 13}, {8, 12}, {2, 10}, {3, 11}, {4, 6}, {7, 9}, {1, 3}, {2, 8},
+	{5, 11}, {6, 7}, {10, 12}, {1, 4}, {2, 6}, {3, 5}, {7, 11}, {8, 10},
+	{9, 12}, {2, 4}, {3, 6}, {5, 8}, {7, 10}, {9, 11}, {3, 4}, {5, 6},
+	{7, 8}, {9, 10}, {6, 7}
+};
+
+// Networks from 16 inputs up, as used before this tool existed
+// The 16 input network is Green's 60 comparator network
+// https://www.cs.brandeis.edu/~hugues/sorting_networks.html
+// Higher networks were built from the data in
+// https://bertdobbelaere.github.io/sorting_networks.html
+static const uint8_t network16[][2] = {
+	{0, 1}, {2, 3}, {4, 5}, {6, 7}, {8, 9}, {10, 11}, {12, 13}, {14, 15},
+	{0, 2}, {4, 6}, {8, 10}, {12, 14}, {1, 3}, {5, 7}, {9, 11}, {13, 15},
+	{0, 4}, {8, 12}, {1, 5}, {9, 13}, {2, 6}, {10, 14}, {3, 7}, {11, 15},
+	{0, 8}, {1, 9}, {2, 10}, {3, 11}, {4, 12}, {5, 13}, {6, 14}, {7, 15},
+	{5, 10}, {6, 9}, {3, 12}, {13, 14}, {7, 11}, {1, 2}, {4, 8}, {1, 4},
+	{7, 13}, {2, 8}, {11, 14}, {2, 4}, {5, 6}, {9, 10}, {11, 13}, {3, 8},
+	{7, 12}, {6, 8}, {10, 12}, {3, 5}, {7, 9}, {3, 4}, {5, 6}, {7, 8},
+	{9, 10}, {11, 12}, {6, 7}, {8, 9}
+};
+
+static const uint8_t network17[][2] = {
+	{0, 11}, {1, 15}, {2, 10}, {3, 5}, {4, 6}, {8, 12}, {9, 16}, {13, 14},
+	{0, 6}, {1, 13}, {2, 8}, {4, 14}, {5, 15}, {7, 11}, {0, 8}, {3, 7},
+	{4, 9}, {6, 16}, {10, 11}, {12, 14}, {0, 2}, {1, 4}, {5, 6}, {7, 13},
+	{8, 9}, {10, 12}, {11, 14}, {15, 16}, {0, 3}, {2, 5}, {6, 11}, {7, 10},
+	{9, 13}, {12, 15}, {14, 16}, {0, 1}, {3, 4}, {5, 10}, {6, 9}, {7, 8},
+	{11, 15}, {13, 14}, {1, 2}, {3, 7}, {4, 8}, {6, 12}, {11, 13}, {14, 15},
+	{1, 3}, {2, 7}, {4, 5}, {9, 11}, {10, 12}, {13, 14}, {2, 3}, {4, 6},
+	{5, 7}, {8, 10}, {3, 4}, {6, 8}, {7, 9}, {10, 12}, {5, 6}, {7, 8},
+	{9, 10}, {11, 12}, {4, 5}, {6, 7}, {8, 9}, {10, 11}, {12, 13}
+};
+
+static const uint8_t network18[][2] = {
+	{0, 1}, {2, 3}, {4, 5}, {6, 7}, {8, 9}, {10, 11}, {12, 13}, {14, 15},
+	{16, 17}, {0, 2}, {1, 3}, {4, 12}, {5, 13}, {6, 8}, {9, 11}, {14, 16},
+	{15, 17}, {0, 14}, {1, 16}, {2, 15}, {3, 17}, {0, 6}, {1, 10}, {2, 9},
+	{7, 16}, {8, 15}, {11, 17}, {1, 4}, {3, 9}, {5, 7}, {8, 14}, {10, 12},
+	{13, 16}, {0, 1}, {2, 5}, {3, 13}, {4, 14}, {7, 9}, {8, 10}, {12, 15},
+	{16, 17}, {1, 2}, {3, 5}, {4, 6}, {11, 13}, {12, 14}, {15, 16}, {4, 8},
+	{5, 12}, {6, 10}, {7, 11}, {9, 13}, {1, 4}, {2, 8}, {3, 6}, {5, 7},
+	{9, 15}, {10, 12}, {11, 14}, {13, 16}, {2, 4}, {5, 8}, {6, 10}, {7, 11},
+	{9, 12}, {13, 15}, {3, 5}, {6, 8}, {7, 10}, {9, 11}, {12, 14}, {3, 4},
+	{5, 6}, {7, 8}, {9, 10}, {11, 12}, {13, 14}
+};
+
+static const uint8_t network19[][2] = {
+	{0, 12}, {1, 4}, {2, 8}, {3, 5}, {6, 17}, {7, 11}, {9, 14}, {10, 13},
+	{15, 16}, {0, 2}, {1, 7}, {3, 6}, {4, 11}, {5, 17}, {8, 12}, {10, 15},
+	{13, 16}, {14, 18}, {3, 10}, {4, 14}, {5, 15}, {6, 13}, {7, 9}, {11, 17},
+	{16, 18}, {0, 7}, {1, 10}, {4, 6}, {9, 15}, {11, 16}, {12, 17}, {13, 14},
+	{0, 3}, {2, 6}, {5, 7}, {8, 11}, {12, 16}, {1, 8}, {2, 9}, {3, 4},
+	{6, 15}, {7, 13}, {10, 11}, {12, 18}, {1, 3}, {2, 5}, {6, 9}, {7, 12},
+	{8, 10}, {11, 14}, {17, 18}, {0, 1}, {2, 3}, {4, 8}, {6, 10}, {9, 12},
+	{14, 15}, {16, 17}, {1, 2}, {5, 8}, {6, 7}, {9, 11}, {10, 13}, {14, 16},
+	{15, 17}, {3, 6}, {4, 5}, {7, 9}, {8, 10}, {11, 12}, {13, 14}, {15, 16},
+	{3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 13}, {12, 14}, {2, 3}, {4, 5},
+	{6, 7}, {8, 9}, {10, 11}, {12, 13}, {14, 15}
+};
+
+static const uint8_t network20[][2] = {
+	{0, 3}, {1, 7}, {2, 5}, {4, 8}, {6, 9}, {10, 13}, {11, 15}, {12, 18},
+	{14, 17}, {16, 19}, {0, 14}, {1, 11}, {2, 16}, {3, 17}, {4, 12}, {5, 19},
+	{6, 10}, {7, 15}, {8, 18}, {9, 13}, {0, 4}, {1, 2}, {3, 8}, {5, 7},
+	{11, 16}, {12, 14}, {15, 19}, {17, 18}, {1, 6}, {2, 12}, {3, 5}, {4, 11},
+	{7, 17}, {8, 15}, {13, 18}, {14, 16}, {0, 1}, {2, 6}, {7, 10}, {9, 12},
+	{13, 17}, {18, 19}, {1, 6}, {5, 9}, {7, 11}, {8, 12}, {10, 14}, {13, 18},
+	{3, 5}, {4, 7}, {8, 10}, {9, 11}, {12, 15}, {14, 16}, {1, 3}, {2, 4},
+	{5, 7}, {6, 10}, {9, 13}, {12, 14}, {15, 17}, {16, 18}, {1, 2}, {3, 4},
+	{6, 7}, {8, 9}, {10, 11}, {12, 13}, {15, 16}, {17, 18}, {2, 3}, {4, 6},
+	{5, 8}, {7, 9}, {10, 12}, {11, 14}, {13, 15}, {16, 17}, {4, 5}, {6, 8},
+	{7, 10}, {9, 12}, {11, 13}, {14, 15}, {3, 4}, {5, 6}, {7, 8}, {9, 10},
+	{11, 12}, {13, 14}, {15, 16}
+};
+
+static const uint8_t network21[][2] = {
+	{0, 1}, {2, 3}, {4, 5}, {6, 7}, {8, 9}, {10, 11}, {12, 13}, {14, 15},
+	{16, 17}, {18, 19}, {0, 2}, {1, 3}, {4, 6}, {5, 7}, {8, 10}, {9, 11},
+	{12, 14}, {13, 15}, {16, 18}, {17, 19}, {0, 8}, {1, 9}, {2, 10}, {3, 11},
+	{4, 12}, {5, 13}, {6, 14}, {7, 15}, {0, 4}, {1, 5}, {3, 7}, {6, 20},
+	{8, 12}, {9, 13}, {10, 14}, {15, 19}, {2, 6}, {3, 18}, {7, 20}, {2, 16},
+	{3, 6}, {5, 18}, {7, 17}, {11, 20}, {0, 2}, {3, 8}, {6, 12}, {7, 10},
+	{9, 16}, {11, 15}, {13, 17}, {14, 18}, {19, 20}, {1, 7}, {2, 3}, {4, 9},
+	{10, 11}, {13, 16}, {15, 18}, {17, 19}, {1, 4}, {5, 10}, {6, 13}, {7, 8},
+	{11, 14}, {12, 16}, {15, 17}, {18, 19}, {1, 2}, {3, 4}, {5, 6}, {10, 12},
+	{11, 13}, {14, 16}, {17, 18}, {2, 3}, {4, 5}, {6, 9}, {10, 11}, {12, 13},
+	{14, 15}, {16, 17}, {6, 7}, {8, 9}, {15, 16}, {4, 6}, {7, 8}, {9, 12},
+	{13, 15}, {3, 4}, {5, 7}, {8, 10}, {9, 11}, {12, 14}, {5, 6}, {7, 8},
+	{9, 10}, {11, 12}, {13, 14}
+};
+
+static const uint8_t network22[][2] = {
+	{0, 1}, {2, 3}, {4, 5}, {6, 7}, {8, 9}, {10, 11}, {12, 13}, {14, 15},
+	{16, 17}, {18, 19}, {20, 21}, {0, 2}, {1, 3}, {4, 6}, {5, 7}, {8, 12},
+	{9, 13}, {14, 16}, {15, 17}, {18, 20}, {19, 21}, {0, 4}, {1, 5}, {2, 6},
+	{3, 7}, {8, 10}, {9, 12}, {11, 13}, {14, 18}, {15, 19}, {16, 20}, {17, 21},
+	{0, 14}, {1, 15}, {2, 18}, {3, 19}, {4, 16}, {5, 17}, {6, 20}, {7, 21},
+	{9, 11}, {10, 12}, {2, 8}, {3, 11}, {6, 9}, {10, 18}, {12, 15}, {13, 19},
+	{0, 2}, {1, 10}, {3, 16}, {5, 18}, {6, 14}, {7, 15}, {8, 12}, {9, 13},
+	{11, 20}, {19, 21}, {2, 6}, {3, 10}, {4, 8}, {5, 12}, {9, 16}, {11, 18},
+	{13, 17}, {15, 19}, {1, 4}, {7, 13}, {8, 14}, {9, 12}, {17, 20}, {1, 2},
+	{3, 8}, {4, 6}, {7, 11}, {10, 14}, {13, 18}, {15, 17}, {19, 20}, {2, 4},
+	{5, 10}, {7, 9}, {11, 16}, {12, 14}, {17, 19}, {5, 6}, {7, 8}, {9, 11},
+	{10, 12}, {13, 14}, {15, 16}, {3, 5}, {6, 7}, {8, 10}, {9, 12}, {11, 13},
+	{14, 15}, {16, 18}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {13, 14},
+	{15, 16}, {17, 18}
+};
+
+static const uint8_t network23[][2] = {
+	{0, 1}, {2, 3}, {4, 5}, {6, 7}, {8, 9}, {10, 11}, {12, 13}, {14, 15},
+	{16, 17}, {18, 19}, {20, 21}, {0, 2}, {1, 3}, {4, 6}, {5, 7}, {8, 10},
+	{9, 11}, {12, 14}, {13, 15}, {16, 18}, {17, 19}, {21, 22}, {0, 4}, {1, 5},
+	{2, 6}, {3, 7}, {8, 12}, {9, 13}, {10, 14}, {11, 15}, {17, 21}, {18, 20},
+	{19, 22}, {0, 8}, {1, 9}, {2, 10}, {3, 11}, {4, 12}, {5, 13}, {6, 14},
+	{7, 15}, {1, 2}, {5, 18}, {7, 19}, {9, 16}, {10, 21}, {12, 20}, {15, 22},
+	{5, 9}, {6, 7}, {10, 18}, {11, 21}, {12, 17}, {13, 20}, {14, 15}, {3, 17},
+	{6, 16}, {7, 14}, {8, 12}, {15, 19}, {20, 21}, {3, 4}, {5, 8}, {6, 10},
+	{9, 12}, {13, 16}, {14, 15}, {17, 18}, {19, 21}, {0, 5}, {1, 8}, {2, 12},
+	{3, 9}, {4, 10}, {7, 13}, {11, 17}, {14, 16}, {18, 20}, {2, 6}, {3, 5},
+	{4, 8}, {7, 11}, {10, 12}, {13, 18}, {14, 17}, {15, 20}, {1, 3}, {2, 5},
+	{6, 9}, {7, 10}, {11, 13}, {12, 14}, {15, 18}, {16, 17}, {19, 20}, {2, 3},
+	{4, 6}, {8, 9}, {11, 12}, {13, 14}, {15, 16}, {17, 19}, {3, 4}, {5, 6},
+	{7, 8}, {9, 10}, {12, 13}, {14, 15}, {17, 18}, {4, 5}, {6, 7}, {8, 9},
+	{10, 11}, {16, 17}
+};
+
+static const uint8_t network24[][2] = {
+	{0, 20}, {1, 12}, {2, 16}, {3, 23}, {4, 6}, {5, 10}, {7, 21}, {8, 14},
+	{9, 15}, {11, 22}, {13, 18}, {17, 19}, {0, 3}, {1, 11}, {2, 7}, {4, 17},
+	{5, 13}, {6, 19}, {8, 9}, {10, 18}, {12, 22}, {14, 15}, {16, 21}, {20, 23},
+	{0, 1}, {2, 4}, {3, 12}, {5, 8}, {6, 9}, {7, 10}, {11, 20}, {13, 16},
+	{14, 17}, {15, 18}, {19, 21}, {22, 23}, {2, 5}, {4, 8}, {6, 11}, {7, 14},
+	{9, 16}, {12, 17}, {15, 19}, {18, 21}, {1, 8}, {3, 14}, {4, 7}, {9, 20},
+	{10, 12}, {11, 13}, {15, 22}, {16, 19}, {0, 7}, {1, 5}, {3, 4}, {6, 11},
+	{8, 15}, {9, 14}, {10, 13}, {12, 17}, {16, 23}, {18, 22}, {19, 20}, {0, 2},
+	{1, 6}, {4, 7}, {5, 9}, {8, 10}, {13, 15}, {14, 18}, {16, 19}, {17, 22},
+	{21, 23}, {2, 3}, {4, 5}, {6, 8}, {7, 9}, {10, 11}, {12, 13}, {14, 16},
+	{15, 17}, {18, 19}, {20, 21}, {1, 2}, {3, 6}, {4, 10}, {7, 8}, {9, 11},
+	{12, 14}, {13, 19}, {15, 16}, {17, 20}, {21, 22}, {2, 3}, {5, 10}, {6, 7},
+	{8, 9}, {13, 18}, {14, 15}, {16, 17}, {20, 21}, {3, 4}, {5, 7}, {10, 12},
+	{11, 13}, {16, 18}, {19, 20}, {4, 6}, {8, 10}, {9, 12}, {11, 14}, {13, 15},
+	{17, 19}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {13, 14}, {15, 16}, {17, 18}
+};
+
+#define STORED_NETWORK(n) {n, network##n, sizeof(network##n) / sizeof(network##n[0])}
+
+static const struct {
+	int length;
+	const uint8_t (*pairs)[2];
+	int count;
+} stored_networks[] = {
+	STORED_NETWORK(2), STORED_NETWORK(3), STORED_NETWORK(4), STORED_NETWORK(5),
+	STORED_NETWORK(6), STORED_NETWORK(7), STORED_NETWORK(8), STORED_NETWORK(9),
+	STORED_NETWORK(10), STORED_NETWORK(11), STORED_NETWORK(12), STORED_NETWORK(13),
+	STORED_NETWORK(14), STORED_NETWORK(16), STORED_NETWORK(17), STORED_NETWORK(18),
+	STORED_NETWORK(19), STORED_NETWORK(20), STORED_NETWORK(21), STORED_NETWORK(22),
+	STORED_NETWORK(23), STORED_NETWORK(24)
+};
+
+static Network best[MAX_LENGTH + 1];
+
+void network_add(Network* network, int a, int b) {
+	if (network->count >= MAX_PAIRS) {
+		fprintf(stderr, "Too many comparators\n");
+		exit(1);
+	}
+	
+	network->pairs[network->count][0] = a;
+	network->pairs[network->count][1] = b;
+	network->count++;
+}
+
+// Appends a network shifted up by the given number of wires
+void network_append(Network* network, const Network* other, int offset) {
+	for (int i = 0; i < other->count; i++) {
+		network_add(network, other->pairs[i][0] + offset, other->pairs[i][1] + offset);
+	}
+}
+
+// Returns the number of layers when every comparator runs as early as possible
+int network_get_depth(const Network* network) {
+	int ready[MAX_PAIRS] = {0};
+	int depth = 0;
+	
+	for (int i = 0; i < network->count; i++) {
+		int a = network->pairs[i][0];
+		int b = network->pairs[i][1];
+		int layer = (ready[a] > ready[b] ? ready[a] : ready[b]) + 1;
+		ready[a] = layer;
+		ready[b] = layer;
+		if (layer > depth) depth = layer;
+	}
+	
+	return depth;
+}
+
+// Checks a network against every 0-1 input, 64 inputs at a time.
+// By the 0-1 principle, a network sorting these sorts any input.
+int network_verify(const Network* network, int length) {
+	static const uint64_t patterns[6] = {
+		0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+		0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull
+	};
+	
+	uint64_t blocks = length > 6 ? 1ull << (length - 6) : 1;
+	uint64_t wires[MAX_LENGTH];
+	
+	for (uint64_t block = 0; block < blocks; block++) {
+		for (int i = 0; i < length; i++) {
+			if (i < 6) wires[i] = patterns[i];
+			else wires[i] = ((block >> (i - 6)) & 1) ? ~0ull : 0;
+		}
+		
+		for (int i = 0; i < network->count; i++) {
+			int a = network->pairs[i][0];
+			int b = network->pairs[i][1];
+			uint64_t low = wires[a] & wires[b];
+			wires[b] |= wires[a];
+			wires[a] = low;
+		}
+		
+		for (int i = 0; i + 1 < length; i++) {
+			if (wires[i] & ~wires[i + 1]) return 0;
+		}
+	}
+	
+	return 1;
+}
+
+// Removes the lowest and highest wires of a network.
+// The lowest wires are taken to hold values below every input and the highest
+// wires values above every input. Those stay in place through any comparator,
+// so every comparator touching them can be dropped.
+void network_prune(const Network* network, int length, int low, int high, Network* result) {
+	result->count = 0;
+	
+	for (int i = 0; i < network->count; i++) {
+		int a = network->pairs[i][0];
+		int b = network->pairs[i][1];
+		if (a < low || b < low || a >= length - high || b >= length - high) continue;
+		network_add(result, a - low, b - low);
+	}
+}
+
+// Batcher's odd-even merge of two sorted runs covering length wires from lo
+void network_add_merge(Network* network, int lo, int length, int step) {
+	int double_step = step * 2;
+	
+	if (double_step < length) {
+		network_add_merge(network, lo, length, double_step);
+		network_add_merge(network, lo + step, length, double_step);
+		for (int i = lo + step; i + step < lo + length; i += double_step) {
+			network_add(network, i, i + step);
+		}
+	} else {
+		network_add(network, lo, lo + step);
+	}
+}
+
+// Sorts a and b inputs with the best networks found so far, then merges them.
+// Both runs are placed around the middle of a power of two sized merge,
+// with the padding pruned away afterwards.
+void network_build_merge(int a, int b, Network* result) {
+	int half = 1;
+	while (half < a || half < b) half *= 2;
+	
+	Network* full = calloc(1, sizeof(Network));
+	network_append(full, &best[a], half - a);
+	network_append(full, &best[b], half);
+	network_add_merge(full, 0, half * 2, 1);
+	network_prune(full, half * 2, half - a, half - b, result);
+	
+	free(full);
+}
+
+// Keeps a candidate if it has fewer comparators, or as many in fewer layers
+int network_offer(int length, Network* candidate) {
+	Network* current = &best[length];
+	
+	if (current->count) {
+		if (candidate->count > current->count) return 0;
+		if (candidate->count == current->count && network_get_depth(candidate) >= network_get_depth(current)) return 0;
+	}
+	
+	*current = *candidate;
+	return 1;
+}
+
+void network_print(const Network* network, int length) {
+	int ready[MAX_LENGTH] = {0};
+	int layer_of[MAX_PAIRS];
+	int depth = 0;
+	
+	for (int i = 0; i < network->count; i++) {
+		int a = network->pairs[i][0];
+		int b = network->pairs[i][1];
+		int layer = ready[a] > ready[b] ? ready[a] : ready[b];
+		layer_of[i] = layer;
+		ready[a] = layer + 1;
+		ready[b] = layer + 1;
+		if (layer + 1 > depth) depth = layer + 1;
+	}
+	
+	printf("// %d comparators in %d layers, %s\n", network->count, depth, network->source);
+	printf("#define NETWORK%d(SWAP) \\\n", length);
+	
+	for (int layer = 0; layer < depth; layer++) {
+		printf("\t");
+		int first = 1;
+		for (int i = 0; i < network->count; i++) {
+			if (layer_of[i] != layer) continue;
+			printf("%sSWAP(%d, %d)", first ? "" : " ", network->pairs[i][0], network->pairs[i][1]);
+			first = 0;
+		}
+		printf(layer + 1 < depth ? " \\\n" : "\n");
+	}
+	
+	printf("\n");
+}
+
+int main(int argc, char** argv) {
+	Network* candidate = calloc(1, sizeof(Network));
+	
+	for (size_t i = 0; i < sizeof(stored_networks) / sizeof(stored_networks[0]); i++) {
+		int length = stored_networks[i].length;
+		
+		candidate->count = 0;
+		for (int j = 0; j < stored_networks[i].count; j++) {
+			network_add(candidate, stored_networks[i].pairs[j][0], stored_networks[i].pairs[j][1]);
+		}
+		snprintf(candidate->source, sizeof(candidate->source), "stored");
+		
+		if (!network_verify(candidate, length)) {
+			fprintf(stderr, "Stored network for %d inputs does not sort\n", length);
+			return 1;
+		}
+		
+		network_offer(length, candidate);
+	}
+	
+	// Derived networks can improve others, so repeat until nothing changes
+	int changed = 1;
+	while (changed) {
+		changed = 0;
+		
+		for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+			for (int larger = length + 1; larger <= MAX_LENGTH; larger++) {
+				if (!best[larger].count) continue;
+				
+				for (int low = 0; low <= larger - length; low++) {
+					network_prune(&best[larger], larger, low, larger - length - low, candidate);
+					snprintf(candidate->source, sizeof(candidate->source), "pruned from %d", larger);
+					changed |= network_offer(length, candidate);
+				}
+			}
+			
+			for (int a = 1; a + a <= length; a++) {
+				int b = length - a;
+				if (a > 1 && !best[a].count) continue;
+				if (!best[b].count) continue;
+				
+				network_build_merge(a, b, candidate);
+				snprintf(candidate->source, sizeof(candidate->source), "merged from %d and %d", a, b);
+				changed |= network_offer(length, candidate);
+			}
+		}
+	}
+	
+	for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+		if (!best[length].count || !network_verify(&best[length], length)) {
+			fprintf(stderr, "No valid network for %d inputs\n", length);
+			return 1;
+		}
+	}
+	
+	printf("#ifndef SORTING_NETWORKS_H\n");
+	printf("#define SORTING_NETWORKS_H\n\n");
+	printf("// Sorting network definitions shared by the scalar and vector sorts.\n");
+	printf("// Generated by tools/network_gen.c (make networks), do not edit by hand.\n");
+	printf("// Each list calls SWAP(a, b) for every comparator in order, with one line per\n");
+	printf("// layer of comparators that touch distinct elements.\n\n");
+	
+	printf("// Calls X(n) for every length with a network\n");
+	printf("#define SORTING_NETWORKS(X) \\\n\t");
+	for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+		printf("X(%d)%s", length, length < MAX_LENGTH ? " " : "\n\n");
+	}
+	
+	for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+		network_print(&best[length], length);
+	}
+	
+	printf("#endif\n");
+	
+	free(candidate);
+	
+	return 0;
+}
@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "reader.h"
+#include "bitface.h"
+#include "rank.h"
+#include "key_list.h"
+#include "point.h"
+
+// Times bulk encoding and decoding of every polycube in a cache file,
+// in the bitface format and as ranks, and checks that every rank decodes
+// back to its bitface string.
+// Usage: rank_bench <cache file> [rounds]
+
+double get_time_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+ReaderMode get_reader_mode(char* filename) {
+	int len = strlen(filename);
+	
+	if (len > 6 && strcmp(&filename[len-6], ".pcube") == 0) return ReadPCube;
+	if (len > 5 && strcmp(&filename[len-5], ".rank") == 0) return ReadRank;
+	
+	return ReadBitFace;
+}
+
+// Reads every key of a cache file into one list
+KeyList* read_all(Reader* reader) {
+	KeyList* chunk = key_list_create(reader_get_n(reader), READER_MAX_COUNT);
+	KeyList* retval = key_list_create(reader_get_n(reader), READER_MAX_COUNT);
+	uint64_t count;
+	
+	while ((count = reader_read_keys(reader, chunk)) > 0) {
+		key_list_reserve(retval, retval->count + count);
+		key_list_copy(retval, retval->count, chunk, 0, count);
+		retval->count += count;
+	}
+	
+	key_list_destroy(chunk);
+	
+	return retval;
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		printf("Usage: rank_bench <cache file> [rounds]\n");
+		return 1;
+	}
+	
+	int rounds = argc > 2 ? atoi(argv[2]) : 3;
+	
+	Reader* reader = reader_create(argv[1], get_reader_mode(argv[1]));
+	if (reader == NULL) return 1;
+	
+	KeyList* keys = read_all(reader);
+	uint8_t length = keys->length;
+	uint64_t count = keys->count;
+	reader_destroy(reader);
+	
+	RankTable* table = rank_table_create(length);
+	if (table == NULL) return 1;
+	uint8_t* places = calloc(POINT_SPACEMAP_SIZE, sizeof(uint8_t));
+	size_t bitface_size = bitface_key_size(length);
+	size_t rank_size = rank_key_size(table);
+	
+	uint8_t* bitfaces = calloc(count, bitface_size);
+	uint8_t* ranks = calloc(count, rank_size);
+	char* decoded = calloc(count, bitface_size);
+	
+	printf("%lld polycubes of length %d: %d bytes per bitface key, %d bytes per rank\n",
+		(long long int) count, length, (int) bitface_size, (int) rank_size);
+	
+	// Best times of: bitface encode, rank encode, rank from bitface, bitface decode, rank decode, bitface from rank
+	double best[6] = {1e30, 1e30, 1e30, 1e30, 1e30, 1e30};
+	double t[6];
+	uint64_t checksum = 0;
+	
+	for (int r = 0; r < rounds; r++) {
+		double start = get_time_ns();
+		bitface_encode_keys(keys, count, bitfaces, places);
+		t[0] = get_time_ns() - start;
+		
+		start = get_time_ns();
+		rank_encode_keys(table, keys, count, ranks, places);
+		t[1] = get_time_ns() - start;
+		
+		start = get_time_ns();
+		for (uint64_t i = 0; i < count; i++) {
+			rank_encode(table, (char*) &bitfaces[i * bitface_size], &ranks[i * rank_size]);
+		}
+		t[2] = get_time_ns() - start;
+		
+		start = get_time_ns();
+		for (uint64_t i = 0; i < count; i++) {
+			Key key = bitface_unpack((char*) &bitfaces[i * bitface_size], length);
+			checksum += key.data[length - 1];
+		}
+		t[3] = get_time_ns() - start;
+		
+		start = get_time_ns();
+		for (uint64_t i = 0; i < count; i++) {
+			char bitface[bitface_size];
+			rank_decode(table, &ranks[i * rank_size], bitface);
+			Key key = bitface_unpack(bitface, length);
+			checksum += key.data[length - 1];
+		}
+		t[4] = get_time_ns() - start;
+		
+		start = get_time_ns();
+		for (uint64_t i = 0; i < count; i++) {
+			rank_decode(table, &ranks[i * rank_size], &decoded[i * bitface_size]);
+		}
+		t[5] = get_time_ns() - start;
+		
+		for (int i = 0; i < 6; i++) {
+			if (t[i] < best[i]) best[i] = t[i];
+		}
+	}
+	
+	if (memcmp(bitfaces, decoded, count * bitface_size) != 0) {
+		printf("Ranks don't decode to their bitface keys\n");
+		return 1;
+	}
+	
+	printf("encode bitface:        %8.1f ns per key\n", best[0] / count);
+	printf("encode rank:           %8.1f ns per key\n", best[1] / count);
+	printf("  rank from bitface:   %8.1f ns per key\n", best[2] / count);
+	printf("decode bitface:        %8.1f ns per key\n", best[3] / count);
+	printf("decode rank:           %8.1f ns per key\n", best[4] / count);
+	printf("  bitface from rank:   %8.1f ns per key\n", best[5] / count);
+	printf("(checksum %lld)\n", (long long int) checksum);
+	
+	free(bitfaces);
+	free(ranks);
+	free(decoded);
+	free(places);
+	rank_table_destroy(table);
+	key_list_destroy(keys);
+	
+	return 0;
+}
@@ -1,16 +1,30 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 #include "worker.h"
 #include "thread_pool.h"
 #include "generator.h"
 #include "point.h"
 
-WorkerData* worker_create(ThreadPool* pool, int input_length, int output_length) {
-	WorkerData* wdata = calloc(1, sizeof(WorkerData));
+WorkerData* worker_create(ThreadPool* pool, int index, int input_length, int output_length) {
+	WorkerData* wdata = thread_pool_alloc_aligned(1, sizeof(WorkerData));
 	
 	wdata->pool = pool;
+	wdata->index = index;
+	wdata->random_state = index + 1;
+	pthread_mutex_init(&wdata->lock, NULL);
 	wdata->input_length = input_length;
 	wdata->output_length = output_length;
+	wdata->count_only = pool->mode == OutputCount;
+	
+	if (pool->mode == OutputKeys) {
+		wdata->batch_keys = key_list_create(output_length, WORKER_BATCH_SIZE);
+	} else if (pool->mode == OutputWriter) {
+		wdata->batch_bytes = calloc(WORKER_BATCH_SIZE, writer_max_key_size(pool->writer));
+		wdata->places = calloc(POINT_SPACEMAP_SIZE, sizeof(uint8_t));
+	}
 	
 	wdata->spacemap = calloc(POINT_SPACEMAP_SIZE, sizeof(uint8_t));
 	
@@ -20,7 +34,11 @@ WorkerData* worker_create(ThreadPool* pool, int input_length, int output_length)
 }
 
 void worker_destroy(WorkerData* wdata) {
+	pthread_mutex_destroy(&wdata->lock);
 	free(wdata->spacemap);
+	if (wdata->batch_keys != NULL) key_list_destroy(wdata->batch_keys);
+	free(wdata->batch_bytes);
+	free(wdata->places);
 	worker_generation_data_destroy(wdata);
 	
 	free(wdata);
@@ -29,65 +47,275 @@ void worker_destroy(WorkerData* wdata) {
 void worker_generation_data_create(WorkerData* wdata) {
 	int count = wdata->output_length - wdata->input_length;
 	
-	GenerationData* retval = calloc(count, sizeof(GenerationData));
+	GenerationData* retval = thread_pool_alloc_aligned(count, sizeof(GenerationData));
 	
 	for (int i = 0; i < count; i++) {
 		retval[i].new_length = wdata->input_length + i + 1;
 		retval[i].total = 0;
+		retval[i].output_keys = key_list_create(retval[i].new_length, WORKER_OUTPUT_SIZE);
 		
 		if (i > 0) retval[i].seed_keys = retval[i-1].output_keys;
 	}
 	
-	retval[0].seed_keys = calloc(WORKER_FETCH_COUNT, sizeof(Key));
+	retval[0].seed_keys = key_list_create(wdata->input_length, WORKER_FETCH_COUNT);
 	
 	wdata->generation_data = retval;
 }
 
 void worker_generation_data_destroy(WorkerData* wdata) {
-	free(wdata->generation_data[0].seed_keys);
+	int count = wdata->output_length - wdata->input_length;
+	
+	for (int i = 0; i < count; i++) {
+		key_list_destroy(wdata->generation_data[i].output_keys);
+	}
+	
+	key_list_destroy(wdata->generation_data[0].seed_keys);
 	free(wdata->generation_data);
 }
 
 void worker_generation_data_init(WorkerData* wdata) {
 	GenerationData* gdata = wdata->generation_data;
 	int levels = wdata->output_length - wdata->input_length;
+	
+	pthread_mutex_lock(&wdata->lock);
 
 	for (int i = 0; i < levels; i++) {
 		gdata[i].seed_count = 0;
 		gdata[i].index = 0;
+		gdata[i].stolen = 0;
 	}
+	
+	pthread_mutex_unlock(&wdata->lock);
 }
 
-void worker_generate_level(GenerationData* gdata, uint8_t* spacemap) {
+// Takes the back half of the unclaimed seeds of another worker's shallowest level
+// that has any, since those have the most work below them.
+// The stolen seeds become this worker's only seeds, at the same level.
+// Only one worker lock is held at a time: the seeds are copied under the victim's lock,
+// which is safe because this worker is idle and none of its levels have seeds to steal,
+// and its levels are only set up under its own lock afterwards.
+// Returns 1 if anything was stolen.
+int worker_steal_level(WorkerData* wdata, WorkerData* victim) {
+	GenerationData* gdata = wdata->generation_data;
+	GenerationData* vdata = victim->generation_data;
+	int levels = wdata->output_length - wdata->input_length;
+	int level = -1;
+	int take = 0;
+	
+	pthread_mutex_lock(&victim->lock);
 	
-	Key seed = gdata->seed_keys[gdata->index];
-	int new_length = gdata->new_length;
+	for (int i = 0; i < levels; i++) {
+		int remaining = vdata[i].seed_count - vdata[i].index;
+		if (remaining <= 0) continue;
 		
-	int n_generated = generator_generate(seed, gdata->new_length, gdata->output_keys, spacemap);
-	qsort(gdata->output_keys, n_generated, sizeof(Key), key_compare);
+		take = (remaining + 1) / 2;
+		vdata[i].seed_count -= take;
+		
+		key_list_copy(gdata[i].seed_keys, 0, vdata[i].seed_keys, vdata[i].seed_count, take);
+		gdata[i].seed_keys->count = take;
+		
+		// The pool sees this worker busy again before the victim can finish
+		thread_pool_set_busy(wdata->pool, 1);
+		level = i;
+		break;
+	}
 	
-	int a = 0;
-	int last_output = 0;
-	Key last = key_get_comparison_maximum(new_length);	
-	for (int j = 0; j < n_generated; j++) {
-		if (key_compare(&last, &gdata->output_keys[j]) == 0 && last_output) continue;
+	pthread_mutex_unlock(&victim->lock);
+	
+	if (level < 0) return 0;
+	
+	pthread_mutex_lock(&wdata->lock);
+	
+	for (int j = 0; j < levels; j++) {
+		gdata[j].seed_count = 0;
+		gdata[j].index = 0;
+	}
+	
+	gdata[level].seed_count = take;
+	gdata[level].stolen = 1;
+	
+	pthread_mutex_unlock(&wdata->lock);
+	
+	return 1;
+}
+
+// Looks for seeds to steal from the other workers, trying them in turn from a random one
+int worker_steal(WorkerData* wdata) {
+	ThreadPool* pool = wdata->pool;
+	int start = rand_r(&wdata->random_state) % pool->n_threads;
+	
+	for (int i = 0; i < pool->n_threads; i++) {
+		int victim_index = (start + i) % pool->n_threads;
+		if (victim_index == wdata->index) continue;
 		
-		last = gdata->output_keys[j];
-		last_output = 0;
+		if (worker_steal_level(wdata, pool->workers[victim_index])) {
+			wdata->level_steals++;
+			return 1;
+		}
+	}
+	
+	return 0;
+}
+
+// Sorts up to WORKER_OUTPUT_SIZE values, using insertion sort on short runs
+// and merging the runs bottom up
+void worker_sort_fingerprints(uint64_t* values, int count) {
+	uint64_t scratch[WORKER_OUTPUT_SIZE];
+	const int run = 8;
+	
+	for (int start = 0; start < count; start += run) {
+		int end = start + run < count ? start + run : count;
 		
+		for (int i = start + 1; i < end; i++) {
+			uint64_t value = values[i];
+			int j = i;
+			while (j > start && values[j - 1] > value) {
+				values[j] = values[j - 1];
+				j--;
+			}
+			values[j] = value;
+		}
+	}
+	
+	uint64_t* src = values;
+	uint64_t* dst = scratch;
+	
+	for (int width = run; width < count; width *= 2) {
+		for (int start = 0; start < count; start += width * 2) {
+			int mid = start + width < count ? start + width : count;
+			int end = start + width * 2 < count ? start + width * 2 : count;
+			int a = start;
+			int b = mid;
 			
-		if (key_has_larger_single_neighbor(gdata->output_keys[j], spacemap)) continue;
+			for (int i = start; i < end; i++) {
+				if (b >= end || (a < mid && src[a] <= src[b])) dst[i] = src[a++];
+				else dst[i] = src[b++];
+			}
+		}
+		
+		uint64_t* swap = src;
+		src = dst;
+		dst = swap;
+	}
+	
+	if (src != values) memcpy(values, src, count * sizeof(uint64_t));
+}
+
+// Marks the keys to keep: one of each set of duplicates, and only if it is
+// the canonical extension of its seed.
+// Instead of sorting whole keys, fingerprints are sorted: the key hash in the high bits
+// and the key index in the low byte. Keys with equal hashes end up next to each other
+// in index order, and full compares split them into groups of equal keys.
+// A group is kept if any member passes the checks, using the first member that does.
+// Returns the number of keys marked.
+int worker_select_keys(const KeyList* keys, uint8_t* spacemap, uint8_t* keep) {
+	int count = keys->count;
+	int selected = 0;
+	uint64_t fingerprints[WORKER_OUTPUT_SIZE];
+	uint8_t done[WORKER_OUTPUT_SIZE];
+	
+	for (int i = 0; i < count; i++) keep[i] = 0;
+	
+	for (int i = 0; i < count; i++) {
+		fingerprints[i] = (key_list_get_hash(keys, i) & ~0xFFull) | i;
+	}
+	
+	worker_sort_fingerprints(fingerprints, count);
+	
+	int start = 0;
+	while (start < count) {
+		uint64_t hash = fingerprints[start] >> 8;
+		int end = start + 1;
+		while (end < count && (fingerprints[end] >> 8) == hash) end++;
+		
+		for (int i = start; i < end; i++) done[i] = 0;
+		
+		for (int i = start; i < end; i++) {
+			if (done[i]) continue;
 			
-		if (key_has_larger_connected_source(gdata->output_keys[j], spacemap)) continue;
+			int leader = fingerprints[i] & 0xFF;
+			int passed = 0;
 			
-		gdata->output_keys[a] = gdata->output_keys[j];
-		a++;
-		last_output = 1;
+			for (int j = i; j < end; j++) {
+				if (done[j]) continue;
+				
+				int index = fingerprints[j] & 0xFF;
+				if (j > i && !key_list_equal(keys, leader, index)) continue;
+				
+				done[j] = 1;
+				if (passed) continue;
+				
+				Key key = key_list_get(keys, index);
+				if (key_has_larger_single_neighbor(&key, spacemap)) continue;
+				if (key_has_larger_connected_source(&key, spacemap)) continue;
+				
+				keep[index] = 1;
+				passed = 1;
+				selected++;
+			}
+		}
 		
+		start = end;
+	}
+	
+	return selected;
+}
+
+// Removes duplicate keys and keys that are not the canonical extension of their seed.
+// Survivors are compacted forward in their original order, so each key moves at most once.
+// Returns the number of keys kept.
+int worker_filter_keys(KeyList* keys, uint8_t* spacemap) {
+	int count = keys->count;
+	uint8_t keep[WORKER_OUTPUT_SIZE];
+	
+	worker_select_keys(keys, spacemap, keep);
+	
+	int a = 0;
+	for (int i = 0; i < count; i++) {
+		if (!keep[i]) continue;
+		
+		if (a != i) key_list_copy(keys, a, keys, i, 1);
+		a++;
+	}
+	
+	keys->count = a;
+	
+	return a;
+}
+
+// Counts the keys the filter would keep, leaving the list as it is.
+// Used on the last level when only the count is needed.
+int worker_count_keys(const KeyList* keys, uint8_t* spacemap) {
+	uint8_t keep[WORKER_OUTPUT_SIZE];
+	
+	return worker_select_keys(keys, spacemap, keep);
+}
+
+// Generates from a seed of a level, which the caller has already claimed.
+// The parent level is NULL for the first level, whose seeds come from the thread pool.
+// With count_only set, the output keys are only counted and left unfiltered in the list.
+void worker_generate_level(GenerationData* gdata, int index, const GenerationData* parent, uint8_t* spacemap, int count_only, GeneratorStats* stats) {
+	
+	Key seed = key_list_get(gdata->seed_keys, index);
+	Point dimensions = key_list_get_dimensions(gdata->seed_keys, index);
+	
+	generator_reset_rotation_sets(gdata->sets);
+	
+	// The parent's rotation sets are still those of the seed this one was generated from,
+	// unless the seeds were stolen from another worker
+#ifdef GENERATOR_INHERIT_ROTATIONS
+	if (parent != NULL && !gdata->stolen) {
+		uint8_t origin = gdata->seed_keys->origins[index];
+		generator_inherit_rotation_set(gdata->sets, &seed, dimensions, parent->sets, origin, stats);
 	}
+#endif
+	
+	generator_generate(&seed, dimensions, gdata->new_length, gdata->output_keys, spacemap, gdata->sets, stats);
+	int a;
+	if (count_only) a = worker_count_keys(gdata->output_keys, spacemap);
+	else a = worker_filter_keys(gdata->output_keys, spacemap);
 		
 	gdata->output_count = a;
-	gdata->index++;
 	gdata->total += a;
 }
 
@@ -95,62 +323,137 @@ void worker_generate_level(GenerationData* gdata, uint8_t* spacemap) {
 // at the required level for output.
 // Returns the number of output_keys generated.
 // Returns -1 if the GenerationData is complete
-int worker_process_chunk(WorkerData* wdata, Key** output_keys) {
+int worker_process_chunk(WorkerData* wdata, KeyList** output_keys) {
 	GenerationData* gdata = wdata->generation_data;
 	int levels = wdata->output_length - wdata->input_length;
 	*output_keys = gdata[levels - 1].output_keys;
 	
 	// Each level that has reached its end will need to be regenerated
 	// Determine how deep this goes by looking at the index of each level
+	// Other workers may steal unclaimed seeds, so the levels are only changed under the lock
+	pthread_mutex_lock(&wdata->lock);
+	
 	int start = levels - 1;
 	for (int i = start; i >= 0; i--) {
 		start = i;
 		
 		if (gdata[i].index < gdata[i].seed_count) break;
 		
+		// Nothing is left to steal while the level is regenerated
 		gdata[i].index = 0;
+		gdata[i].seed_count = 0;
 		
-		if (i == 0) return -1;
+		if (i == 0) {
+			pthread_mutex_unlock(&wdata->lock);
+			return -1;
+		}
 	}
 	
+	// Claim the seed to generate from, so it can't be stolen
+	int index = gdata[start].index;
+	gdata[start].index++;
+	
+	pthread_mutex_unlock(&wdata->lock);
+	
 	// Process only the levels that need to be regenerated
 	// from the bottom up
 	for (int i = start; i < levels; i++) {
-		if (gdata[i].seed_count > 0) worker_generate_level(&gdata[i], wdata->spacemap);
-		else gdata[i].output_count = 0;
+		int count_only = wdata->count_only && i == levels - 1;
+		
+		if (index >= 0) worker_generate_level(&gdata[i], index, i > 0 ? &gdata[i - 1] : NULL, wdata->spacemap, count_only, &wdata->stats);
+		else {
+			gdata[i].output_count = 0;
+			gdata[i].output_keys->count = 0;
+		}
 		
 		if ((i + 1) < levels) {
-			gdata[i + 1].seed_count = gdata[i].output_count;
+			int count = gdata[i].output_count;
+			index = count > 0 ? 0 : -1;
+			
+			pthread_mutex_lock(&wdata->lock);
+			gdata[i + 1].seed_count = count;
+			gdata[i + 1].index = count > 0 ? 1 : 0;
+			gdata[i + 1].stolen = 0;
+			pthread_mutex_unlock(&wdata->lock);
 		}
 	}
 
 	return gdata[levels - 1].output_count;
 }
 
-uint64_t worker_get_total(WorkerData* wdata, int index) {;
+// Pushes the collected output keys to the pool
+void worker_push_batch(WorkerData* wdata) {
+	if (wdata->batch_bytes != NULL) {
+		thread_pool_push_bytes(wdata->pool, wdata->batch_bytes, wdata->batch_size, wdata->batch_count);
+		wdata->batch_size = 0;
+		wdata->batch_count = 0;
+	} else {
+		thread_pool_push_output(wdata->pool, wdata->batch_keys, wdata->batch_keys->count);
+		wdata->batch_keys->count = 0;
+	}
+}
+
+// Collects output keys, so the pool's output lock is only taken once a batch is full.
+// Keys for a file are encoded here, so the writer thread doesn't have to.
+void worker_add_output(WorkerData* wdata, KeyList* output_keys, int output_count) {
+	if (wdata->batch_bytes != NULL) {
+		if (wdata->batch_count + output_count > WORKER_BATCH_SIZE) worker_push_batch(wdata);
+		
+		wdata->batch_size += writer_encode_keys(wdata->pool->writer, output_keys, output_count, 
+			&wdata->batch_bytes[wdata->batch_size], wdata->places);
+		wdata->batch_count += output_count;
+		return;
+	}
+	
+	KeyList* batch = wdata->batch_keys;
+	
+	if (batch->count + output_count > WORKER_BATCH_SIZE) worker_push_batch(wdata);
+	
+	key_list_copy(batch, batch->count, output_keys, 0, output_count);
+	batch->count += output_count;
+}
+
+uint64_t worker_get_total(WorkerData* wdata, int index) {
 	
 	return wdata->generation_data[index].total;
 }
 
 void* worker_thread_function(void* arg) {
 	WorkerData* wdata = (WorkerData*) arg;
-	Key* output_keys = NULL;
+	KeyList* output_keys = NULL;
 	
 	while (1) {
 		worker_generation_data_init(wdata);
 		
-		int fetch_count = thread_pool_fetch_seeds(wdata->pool, wdata->generation_data[0].seed_keys);
+		int fetch_count = thread_pool_fetch_seeds(wdata->pool, wdata->index, wdata->generation_data[0].seed_keys);
 				
-		if (fetch_count == 0) break;
-		
-		wdata->generation_data[0].seed_count = fetch_count;
+		if (fetch_count > 0) {
+			pthread_mutex_lock(&wdata->lock);
+			wdata->generation_data[0].seed_count = fetch_count;
+			pthread_mutex_unlock(&wdata->lock);
+		} else {
+			// With no seeds left to fetch, help the workers that are still busy
+			// by stealing from their levels, until none of them are
+			thread_pool_set_busy(wdata->pool, 0);
+			
+			while (!worker_steal(wdata)) {
+				if (thread_pool_get_busy(wdata->pool) == 0) {
+					if (!wdata->count_only) worker_push_batch(wdata);
+					pthread_exit(NULL);
+				}
+				
+				wdata->idle_waits++;
+				usleep(WORKER_IDLE_WAIT);
+			}
+		}
 		
 		while (1) {
 			int result = worker_process_chunk(wdata, &output_keys);
 			
 			if (result < 0) break;
 			
-			thread_pool_push_output(wdata->pool, output_keys, result);
+			// Counts are summed from the level totals when the workers finish
+			if (!wdata->count_only && result > 0) worker_add_output(wdata, output_keys, result);
 		}
 	}
 
@@ -2,39 +2,76 @@
 #include <stdint.h>
 
 #include "key.h"
+#include "key_list.h"
 #include "thread_pool.h"
+#include "generator.h"
 
 #ifndef WORKER_H
 #define WORKER_H
 
 #define WORKER_FETCH_COUNT 5
+#define WORKER_OUTPUT_SIZE 180
+#define WORKER_IDLE_WAIT 100 // Microseconds an idle worker waits between steal attempts
+#define WORKER_BATCH_SIZE 4096 // Output keys a worker collects before pushing them to the pool
 
 typedef struct {
-	Key* seed_keys;
+	KeyList* seed_keys;
 	int seed_count;
-	Key output_keys[180];
+	KeyList* output_keys;
 	int output_count;
 	int new_length;
 	int index;
 	uint64_t total;
+	int stolen; // Seeds were taken from another worker, so the parent level didn't generate them
+	RotationSet sets[GENERATOR_NUM_SETS]; // Rotation sets of the last seed generated from
 } GenerationData;
 
-typedef struct {
+// Workers are allocated on their own cache lines, since each one updates
+// its counters and lock for every seed
+typedef struct __attribute__((aligned(THREAD_POOL_CACHE_LINE))) WorkerData {
+	int index; // Position in the thread pool
 	int input_length;
 	int output_length;
 	GenerationData* generation_data;
 	uint8_t* spacemap;
 	ThreadPool* pool;
 	int cache_count;
+	int count_only; // The pool only counts, so the last level's keys are never kept
+	KeyList* batch_keys; // Output keys not pushed to the pool yet, when they are kept in memory
+	
+	// When writing a file, output keys are encoded by the worker, and the writer only writes the bytes
+	uint8_t* batch_bytes; // Encoded output keys not pushed to the pool yet
+	size_t batch_size; // Bytes in the batch
+	int batch_count; // Keys in the batch
+	uint8_t* places; // Zeroed map used while packing keys
+	GeneratorStats stats;
+	
+	// Seeds of the levels that are not claimed yet can be stolen by idle workers.
+	// The lock guards the seed counts and indexes of the levels.
+	pthread_mutex_t lock;
+	unsigned int random_state; // Picks the first worker to steal from
+	uint64_t level_steals; // Times seeds were stolen from another worker's levels
+	uint64_t idle_waits; // Times no worker had seeds to steal
 } WorkerData;
 
-WorkerData* worker_create(ThreadPool* pool, int input_length, int output_length);
+WorkerData* worker_create(ThreadPool* pool, int index, int input_length, int output_length);
 void worker_destroy(WorkerData* wdata);
 
 void worker_generation_data_create(WorkerData* wdata);
 void worker_generation_data_destroy(WorkerData* wdata);
 
-int worker_process_chunk(WorkerData* wdata, Key** output_keys);
+void worker_sort_fingerprints(uint64_t* values, int count);
+int worker_select_keys(const KeyList* keys, uint8_t* spacemap, uint8_t* keep);
+int worker_filter_keys(KeyList* keys, uint8_t* spacemap);
+int worker_count_keys(const KeyList* keys, uint8_t* spacemap);
+
+int worker_steal_level(WorkerData* wdata, WorkerData* victim);
+int worker_steal(WorkerData* wdata);
+
+void worker_push_batch(WorkerData* wdata);
+void worker_add_output(WorkerData* wdata, KeyList* output_keys, int output_count);
+
+int worker_process_chunk(WorkerData* wdata, KeyList** output_keys);
 void* worker_thread_function (void* arg);
 
 uint64_t worker_get_total(WorkerData* wdata, int index);
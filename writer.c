@@ -3,16 +3,18 @@
 #include "bitface.h"
 #include "pcube.h"
 
-Writer* writer_create(char* filename, WriterMode mode, uint8_t length, int compressed) {
+// Compression uses compress_threads threads on blocks of block_size bytes when there is more than one
+Writer* writer_create(char* filename, WriterMode mode, uint8_t length, int compressed, int compress_threads, size_t block_size) {
 	Writer* retval = calloc(1, sizeof(Writer));
 	
-	if (mode == WriteBitFace && compressed) {
-		printf("Compression not implemented in BitFace mode\n");
+	if (mode != WritePCube && compressed) {
+		printf("Compression only implemented in PCube mode\n");
 		compressed = 0;
 	}
 	
-	retval->stream = output_stream_create(filename, compressed);
+	retval->stream = output_stream_create(filename, compressed, compress_threads, block_size);
 	retval->mode = mode;
+	retval->length = length;
 	retval->spacemap = calloc(POINT_SPACEMAP_SIZE, sizeof(uint8_t));
 	
 	switch(mode) {
@@ -22,10 +24,22 @@ Writer* writer_create(char* filename, WriterMode mode, uint8_t length, int compr
 			break;
 		case WritePCube:
 			printf("Starting file writer in PCube mode");
-			if (compressed) printf(" with compression");
+			if (compressed && compress_threads > 1) printf(" with compression on %d threads", compress_threads);
+			else if (compressed) printf(" with compression");
 			printf(".\n");
 			pcube_write_header(retval->stream, compressed);
 			break;
+		case WriteRank:
+			printf("Starting file writer in Rank mode.\n");
+			retval->rank_table = rank_table_create(length);
+			if (retval->rank_table == NULL) {
+				output_stream_destroy(retval->stream);
+				free(retval->spacemap);
+				free(retval);
+				return NULL;
+			}
+			bitface_write_n(retval->stream, length);
+			break;
 	}
 	
 	return retval;
@@ -35,11 +49,12 @@ void writer_destroy(Writer* writer) {
 	output_stream_flush(writer->stream);
 	output_stream_destroy(writer->stream);
 	free(writer->spacemap);
+	if (writer->rank_table != NULL) rank_table_destroy(writer->rank_table);
 	
 	free(writer);
 }
 
-void writer_write_keys(Writer* writer, Key* keys, uint64_t count) {
+void writer_write_keys(Writer* writer, KeyList* keys, uint64_t count) {
 	switch (writer->mode) {
 		case WriteBitFace:
 			bitface_write_keys(writer->stream, keys, count, writer->spacemap);
@@ -47,7 +62,45 @@ void writer_write_keys(Writer* writer, Key* keys, uint64_t count) {
 		case WritePCube:
 			pcube_write_keys(writer->stream, keys, count);
 			break;
+		case WriteRank:
+			rank_write_keys(writer->stream, writer->rank_table, keys, count, writer->spacemap);
+			break;
+	}
+}
+
+// Upper bound on the bytes a key takes in the file
+size_t writer_max_key_size(Writer* writer) {
+	switch (writer->mode) {
+		case WriteBitFace:
+			return bitface_key_size(writer->length);
+		case WritePCube:
+			return pcube_max_key_size(writer->length);
+		case WriteRank:
+			return rank_key_size(writer->rank_table);
+	}
+	
+	return 0;
+}
+
+// Encodes keys in the file format without writing them, so any thread can do it.
+// The places map must be all zero, and is left that way.
+// Returns the number of bytes written to the buffer.
+size_t writer_encode_keys(Writer* writer, const KeyList* keys, uint64_t count, uint8_t* buffer, uint8_t* places) {
+	switch (writer->mode) {
+		case WriteBitFace:
+			return bitface_encode_keys(keys, count, buffer, places);
+		case WritePCube:
+			return pcube_encode_keys(keys, count, buffer);
+		case WriteRank:
+			return rank_encode_keys(writer->rank_table, keys, count, buffer, places);
 	}
+	
+	return 0;
+}
+
+// Writes keys encoded by writer_encode_keys
+void writer_write_bytes(Writer* writer, uint8_t* buffer, size_t size) {
+	output_stream_write(writer->stream, buffer, size);
 }
 
 void writer_write_count(Writer* writer, uint64_t count) {
@@ -58,5 +111,7 @@ void writer_write_count(Writer* writer, uint64_t count) {
 			output_stream_flush(writer->stream);
 			pcube_write_count(writer->stream, count);
 			break;
+		case WriteRank:
+			break;
 	}
 }
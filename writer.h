@@ -2,23 +2,31 @@
 #include <stdint.h>
 
 #include "key.h"
+#include "key_list.h"
 #include "output_stream.h"
+#include "rank.h"
 
 #ifndef WRITER_H
 #define WRITER_H
 
-typedef enum {WriteBitFace, WritePCube} WriterMode;
+typedef enum {WriteBitFace, WritePCube, WriteRank} WriterMode;
 
 typedef struct {
 	OutputStream* stream;
 	WriterMode mode;
+	uint8_t length;
 	uint8_t* spacemap;
+	RankTable* rank_table; // Only in rank mode
 } Writer;
 
-Writer* writer_create(char* filename, WriterMode mode, uint8_t length, int compressed);
+Writer* writer_create(char* filename, WriterMode mode, uint8_t length, int compressed, int compress_threads, size_t block_size);
 void writer_destroy(Writer* writer);
 
-void writer_write_keys(Writer* writer, Key* output_keys, uint64_t count);
+void writer_write_keys(Writer* writer, KeyList* output_keys, uint64_t count);
+size_t writer_max_key_size(Writer* writer);
+size_t writer_encode_keys(Writer* writer, const KeyList* keys, uint64_t count, uint8_t* buffer, uint8_t* places);
+void writer_write_bytes(Writer* writer, uint8_t* buffer, size_t size);
+
 void writer_write_count(Writer* writer, uint64_t count);
 
 #endif